@@ -82,3 +82,211 @@ unsigned CheckYDimensionOfMatrixFromFile(const std::string &filename, const std:
 
 
 
+// -------------------------
+// Bit-packed black-and-white BinField
+// -------------------------
+
+BinField<bool>::BinField(const unsigned &Nx,
+                         const unsigned &Ny,
+                         const bool &value) :
+Nx_ ( Nx ), Ny_ ( Ny ), Nw_ ( (Nx_+63)/64 ), words_ ( std::vector< uint64_t > (Nw_*Ny_, 0) )
+{
+  // nothing to assign in an empty field
+  if(value && Nx_ > 0 && Ny_ > 0)
+    assign_block(0,Nx_-1,0,Ny_-1,true);
+}
+
+BinField<bool>::BinField(const unsigned &N,
+                         const bool &value) :
+Nx_ ( N ), Ny_ ( N ), Nw_ ( (Nx_+63)/64 ), words_ ( std::vector< uint64_t > (Nw_*Ny_, 0) )
+{
+  // nothing to assign in an empty field
+  if(value && Nx_ > 0 && Ny_ > 0)
+    assign_block(0,Nx_-1,0,Ny_-1,true);
+}
+
+BinField<bool>::BinField(const std::string &filename,
+                         const std::string &prefix_if) :
+Nx_ ( CheckXDimensionOfMatrixFromFile(filename,prefix_if) ), Ny_ ( CheckYDimensionOfMatrixFromFile(filename,prefix_if) ),
+Nw_ ( (Nx_+63)/64 ), words_ ( std::vector< uint64_t > (Nw_*Ny_, 0) )
+{
+  std::ifstream FromFile( (prefix_if + filename).c_str() );
+  if(FromFile.fail()){
+    std::cerr << "ERROR: ifstream failed to read the matrix from " << prefix_if << filename << ";" << std::endl;
+    exit(-1);
+  }
+  std::string dummy;
+  char outlook;
+
+  for(unsigned yi = 0; yi < Ny_; yi++){
+    for(int xi = 0; xi < int(Nx_); xi++){
+      if(FromFile.eof())
+        MatrixFromFileError(filename,xi,yi,prefix_if);
+      FromFile >> dummy;
+      outlook = *(dummy.begin());
+      if ( (outlook >= '0') && (outlook <= '9') ){
+        std::stringstream dump(dummy);
+        bool value = false;
+        dump >> value;
+        assign(xi,yi,value);
+      }
+      else{
+        xi--;
+      }
+    }
+  }
+
+  FromFile.close();
+}
+
+void BinField<bool>::MatrixFromFile(const std::string &filename, const std::string &prefix_if)
+{
+  std::ifstream FromFile( (prefix_if + filename).c_str() );
+  if(FromFile.fail()){
+    std::cerr << "ERROR: ifstream failed to read the matrix from " << prefix_if << filename << ";" << std::endl;
+    exit(-1);
+  }
+  std::string dummy;
+  char outlook;
+
+  for(unsigned yi = 0; yi < Ny_; yi++){
+    for(int xi = 0; xi < int(Nx_); xi++){
+      if(FromFile.eof())
+        MatrixFromFileError(filename,xi,yi,prefix_if);
+      FromFile >> dummy;
+      outlook = *(dummy.begin());
+      if ( (outlook >= '0') && (outlook <= '9') ){
+        std::stringstream dump(dummy);
+        bool value = false;
+        dump >> value;
+        assign(xi,yi,value);
+      }
+      else{
+        xi--;
+      }
+    }
+  }
+
+  int endline = 0;
+  if(!FromFile.eof()){
+    FromFile >> endline;
+    if(endline != 0 && !FromFile.eof())
+      MatrixFromFileWarning(filename,prefix_if);
+  }
+
+  FromFile.close();
+}
+
+void BinField<bool>::MatrixToFile(const std::string &filename, const std::string &prefix_of) const
+{
+  std::ofstream Outfile( (prefix_of + filename).c_str() );
+  for(unsigned yi = 0; yi < Ny_; yi++)
+    {
+      for(unsigned xi = 0; xi < Nx_; xi++)
+        Outfile << std::setw(15) << call(xi,yi);
+      Outfile << std::endl;
+    }
+  Outfile.close();
+}
+
+void BinField<bool>::fout(const std::string &filename, const std::string &prefix_of) const
+{
+  std::ofstream OutFile( (prefix_of + filename).c_str() );
+  for(unsigned yi = Ny_; yi > 0; yi--)
+    {
+      for(unsigned xi = 0; xi < Nx_; xi++)
+        OutFile << std::setw(15) << call(xi,yi-1);
+      OutFile << std::endl;
+    }
+  OutFile.close();
+}
+
+void BinField<bool>::xout(const unsigned &precision) const
+{
+  xout(0,Nx_-1,0,Ny_-1,precision);
+}
+
+void BinField<bool>::xout(const unsigned &xlow, const unsigned &xup, const unsigned &ylow, const unsigned &yup, const unsigned &precision) const
+{
+  std::cout << "Values of the BinField arranged following cartesian coordinates:" << std::endl;
+  std::cout << std::endl;
+  for(unsigned yi = yup+1; yi > ylow; yi--)
+    {
+      for(unsigned xi = xlow; xi <= xup; xi++)
+        std::cout << std::setw(precision) << call(xi,yi-1);
+      std::cout << std::endl;
+    }
+  std::cout << std::endl;
+}
+
+BinField<bool> BinField<bool>::subgrid (const unsigned &start_x, const unsigned &end_x, const unsigned &start_y, const unsigned &end_y)
+{
+  // includes start and end, i.e., starts from start_x, goes up to end_x (same for y)
+  // counting starts at 0
+
+  BinField<bool> tmp(end_x-start_x+1,end_y-start_y+1,false);
+  for(unsigned xi = 0; xi < end_x-start_x+1; xi++)
+    for(unsigned yi = 0; yi < end_y-start_y+1; yi++){
+      tmp.assign(xi,yi,call(xi+start_x,yi+start_y));
+    }
+
+  return tmp;
+}
+
+unsigned BinField<bool>::xi(const unsigned &ni){
+  return ni/Ny_;
+}
+
+unsigned BinField<bool>::yi(const unsigned &ni){
+  return ni - (ni/Ny_)*Ny_;
+}
+
+void BinField<bool>::assign_block(const unsigned &start_x, const unsigned &end_x, const unsigned &start_y, const unsigned &end_y, const bool &value)
+{
+  // includes start and end, i.e., starts from start_x, goes up to end_x (same for y)
+  const unsigned start_wi = start_x >> 6;
+  const unsigned end_wi = end_x >> 6;
+
+  for(unsigned wi = start_wi; wi <= end_wi; wi++){
+    // bits of the current word that lie within [start_x,end_x]
+    uint64_t mask = ~uint64_t(0);
+    if(wi == start_wi)
+      mask &= ~uint64_t(0) << (start_x & 63);
+    if(wi == end_wi && (end_x & 63) != 63)
+      mask &= (uint64_t(1) << ((end_x & 63) + 1)) - 1;
+
+    for(unsigned yi = start_y; yi <= end_y; yi++){
+      if(value)
+        words_[yi*Nw_ + wi] |= mask;
+      else
+        words_[yi*Nw_ + wi] &= ~mask;
+    }
+  }
+}
+
+void BinField<bool>::invert()
+{
+  if(Nx_ == 0 || Ny_ == 0)
+    return;
+  for(unsigned yi = 0; yi < Ny_; yi++){
+    for(unsigned wi = 0; wi < Nw_-1; wi++)
+      words_[yi*Nw_ + wi] = ~words_[yi*Nw_ + wi];
+    words_[yi*Nw_ + Nw_-1] = ~words_[yi*Nw_ + Nw_-1] & padding_mask();
+  }
+}
+
+void BinField<bool>::MatrixFromFileError(const std::string &filename, const unsigned &xi, const unsigned &yi,
+                                         const std::string &prefix_if) const
+{
+  std::cerr << "ERROR: MatrixFromFile recieved matrix from " << prefix_if << filename << ";" << std::endl
+            << "       Dimension mismatch!" << std::endl
+            << "       Needed " << Nx_ << " x " << Ny_ << " matrix;" << std::endl
+            << "       Failed at position xi = " << xi << ", yi = " << yi << ";" << std::endl;
+  exit(-1);
+}
+
+void BinField<bool>::MatrixFromFileWarning(const std::string &filename, const std::string &prefix_if) const
+{
+  std::cerr << "WARNING: MatrixFromFile recieved matrix from " << prefix_if << filename << ";" << std::endl
+            << "         There might be data loss!" << std::endl;
+}
@@ -10,6 +10,7 @@
 
 #include <fstream>
 #include <sstream>
+#include <stdint.h>
 #include "aux.h"
 
 unsigned CheckXDimensionOfMatrixFromFile(const std::string &filename, const std::string &prefix_if);
@@ -528,5 +529,132 @@ void BinField<valuetype>::MatrixFromFileWarning(const std::string &filename, con
 }
 
 
+// -------------------------
+// Bit-packed black-and-white BinField
+//
+// One row (fixed yi) after the other, each row is a run of Nw_ 64-bit words.
+// Pixel (xi,yi) is bit xi%64 of word xi/64 in row yi; the padding bits beyond
+// Nx_ in the last word of each row are always zero.
+// -------------------------
+template < >
+class BinField<bool> {
+
+ public:
+  BinField(const unsigned &Nx, const unsigned &Ny, const bool &value);
+  BinField(const unsigned &N, const bool &value);
+  BinField(const std::string &filename, const std::string &prefix_if);
+
+  void MatrixFromFile(const std::string &filename, const std::string &prefix_if);
+  void MatrixToFile(const std::string &filename, const std::string &prefix_of) const;
+  void fout(const std::string &filename, const std::string &prefix_of) const;
+  void xout(const unsigned &precision=15) const;
+  void xout(const unsigned &xlow, const unsigned &xup, const unsigned &ylow, const unsigned &yup, const unsigned &precision=15) const;
+
+  BinField<bool> subgrid (const unsigned &start_x, const unsigned &end_x, const unsigned &start_y, const unsigned &end_y);
+
+  unsigned call_Nx() const;
+  unsigned call_Ny() const;
+  bool call(const unsigned &xi, const unsigned &yi) const;
+  bool call(const unsigned &ni) const;
+
+  void assign(const unsigned &xi, const unsigned &yi, const bool &value);
+  void assign(const unsigned &ni, const bool &value);
+
+  unsigned xi(const unsigned &ni);
+  unsigned yi(const unsigned &ni);
+
+  // Word-level access: 64 pixels of a row per word
+  unsigned call_Nw() const;
+  uint64_t call_word(const unsigned &wi, const unsigned &yi) const;
+  void assign_word(const unsigned &wi, const unsigned &yi, const uint64_t &word);
+  const uint64_t* row(const unsigned &yi) const;
+
+  // Set all pixels from start_x to end_x and from start_y to end_y (including start and end)
+  void assign_block(const unsigned &start_x, const unsigned &end_x, const unsigned &start_y, const unsigned &end_y, const bool &value);
+  // Turn true into false and vice versa
+  void invert();
+
+ private:
+  const unsigned Nx_;
+  const unsigned Ny_;
+  const unsigned Nw_;
+  std::vector< uint64_t > words_;
+
+  uint64_t padding_mask() const;
+  void MatrixFromFileError(const std::string &filename, const unsigned &xi, const unsigned &yi,
+                           const std::string &prefix_if) const;
+  void MatrixFromFileWarning(const std::string &filename, const std::string &prefix_if) const;
+};
+
+inline unsigned BinField<bool>::call_Nx() const
+{
+  return Nx_;
+}
+
+inline unsigned BinField<bool>::call_Ny() const
+{
+  return Ny_;
+}
+
+inline bool BinField<bool>::call(const unsigned &xi, const unsigned &yi) const
+{
+  return (words_[yi*Nw_ + (xi >> 6)] >> (xi & 63)) & 1;
+}
+
+inline bool BinField<bool>::call(const unsigned &ni) const
+{
+  // In one loop through the bin-field:
+  // one x-column after the other from bottom to top
+  return call(ni/Ny_,ni%Ny_);
+}
+
+inline void BinField<bool>::assign(const unsigned &xi, const unsigned &yi, const bool &value)
+{
+  uint64_t &word = words_[yi*Nw_ + (xi >> 6)];
+  const uint64_t bit = uint64_t(1) << (xi & 63);
+  if(value)
+    word |= bit;
+  else
+    word &= ~bit;
+}
+
+inline void BinField<bool>::assign(const unsigned &ni, const bool &value)
+{
+  assign(ni/Ny_,ni%Ny_,value);
+}
+
+inline unsigned BinField<bool>::call_Nw() const
+{
+  return Nw_;
+}
+
+inline uint64_t BinField<bool>::call_word(const unsigned &wi, const unsigned &yi) const
+{
+  return words_[yi*Nw_ + wi];
+}
+
+inline void BinField<bool>::assign_word(const unsigned &wi, const unsigned &yi, const uint64_t &word)
+{
+  // keep the padding bits zero
+  if(wi == Nw_-1)
+    words_[yi*Nw_ + wi] = word & padding_mask();
+  else
+    words_[yi*Nw_ + wi] = word;
+}
+
+inline const uint64_t* BinField<bool>::row(const unsigned &yi) const
+{
+  return &words_[yi*Nw_];
+}
+
+inline uint64_t BinField<bool>::padding_mask() const
+{
+  // valid bits of the last word in each row
+  if(Nx_ % 64 == 0)
+    return ~uint64_t(0);
+  else
+    return (uint64_t(1) << (Nx_ % 64)) - 1;
+}
+
 
 #endif /* BINFIELD_H_ */
@@ -21,90 +21,180 @@
 
 #include "init.h"
 #include "minkowski.h"
+#include "fractal.h"
+#include "ensemble.h"
 
 static std::string config_file = "FractalPercolationMink.conf";
 static std::string prefix_of = "output/";
 static double p = 0.5;
+static std::vector<double> p_list;
 static unsigned subdivision = 3;
 static unsigned n_approximations = 3;
+static bool all_levels = false;
+static bool cluster_sizes = false;
 static unsigned N_runs = 100;
+static unsigned first_run = 0;
 static bool imageout = false;
 static unsigned seed = 17;
+static unsigned N_threads = 1;
+
+// the final approximation is evaluated along the subdivision tree instead of streaming its rows
+// if few pixels survive (see max_surviving_fraction_minkowski_pix)
+static bool evaluate_along_tree = false;
+
+// One worker of the ensemble of simulation runs, which owns its approximations;
+// the random numbers of a run are keyed by (seed, run)
+class Simulation {
+
+ public:
+  Simulation();
+
+  // observables[li] = Euler characteristic of the surviving cells at the li-th recorded level,
+  // or, for a sweep over p_list, observables[pi] = the one of the final approximation at p_list[pi]
+  void run(const unsigned &run, std::vector<double> &observables);
+
+ private:
+  // all levels 0...n_approximations if all_levels, else none (the final approximation is streamed row by row)
+  std::vector< BinField<bool> > approximations_;
+};
+
+// Euler characteristic of the surviving cells
+int surviving_euler_characteristic(const BinField<bool> &approximation);
+
+// Recorded levels of approximation
+unsigned level(const unsigned &li);
 
 int main(int clc, char* clv[]){
   // Read in parameters
-  initialize(clc, clv, config_file, prefix_of, p, subdivision, n_approximations, N_runs, imageout, seed);
-  // update_seed 
-  seed *= int(p*100+1e-10);
+  initialize(clc, clv, config_file, prefix_of, p, p_list, subdivision, n_approximations, all_levels, cluster_sizes, N_runs, first_run, imageout, seed, N_threads);
+  if(cluster_sizes){
+    std::cerr << "ERROR: the distribution of the cluster sizes is only available for the percolating cluster (FractalPercolationMink_NN_percolating_cluster);" << std::endl;
+    exit(-1);
+  }
+  // a sweep over p_list evaluates the same realizations at every p,
+  // which are drawn in one pass from decreasing p on
+  bool sweep = !p_list.empty();
+  if(sweep && all_levels){
+    std::cerr << "ERROR: a sweep over p_list records only the final approximation (all_levels = 0);" << std::endl;
+    exit(-1);
+  }
+  if(!sweep)
+    p_list.push_back(p);
+  std::sort(p_list.begin(), p_list.end(), std::greater<double>());
+
+  // update_seed (without p for a sweep)
+  if(!sweep)
+    seed *= int(p*100+1e-10);
   seed *= 1000;
   seed += subdivision*100;
   seed += n_approximations;
-  seed *= 100000;
-  seed += N_runs; 
+  // the run index is the second half of the key of the CounterRNG, so that
+  // run r is the same realization for any N_runs, first_run, or number of threads
+
+  // the file names of a sweep tell all p apart (two digits as before otherwise)
+  unsigned p_precision = DistinctPrecision(p_list);
+
+  evaluate_along_tree = !sweep && !all_levels && pow(p,n_approximations) < max_surviving_fraction_minkowski_pix;
+
+  unsigned N_levels = all_levels ? n_approximations : 1;
+  EnsembleSums sums = RunEnsemble<Simulation>(N_levels*p_list.size(), first_run, N_runs, N_threads);
+
+  for(unsigned oi = 0; oi < sums.call_N_observables(); oi++){
+    unsigned k = level(oi % N_levels);
+    double p = p_list[oi / N_levels];
+    double mean_actual_chi = sums.mean(oi);
+    double std_error_actual_chi = sums.std_error(oi);
+
+    std::stringstream outputstst;
+    outputstst << prefix_of << "frac-perc-mink-val-NN-" << subdivision << "x" << subdivision << "-n-" << k << "-p-" << std::setprecision(p_precision) << p << ".dat";
+    std::ofstream output(outputstst.str().c_str());
+    output << p << " " << mean_actual_chi*pow(1./pow(subdivision,2)/p,k) << " " << std_error_actual_chi*pow(1./pow(subdivision,2)/p,k) << " " << k << std::endl;
+    output.close();
+  }
 
+  return 0;
+}
+
+
+Simulation::Simulation()
+{
+  if(all_levels)
+    for(unsigned k = 0; k <= n_approximations; k++)
+      approximations_.push_back(BinField<bool>(pow(subdivision,k), false));
+}
+
+void Simulation::run(const unsigned &run, std::vector<double> &observables)
+{
   // black = true = death
   // white = false = no death = survival
-  double p_turning_black = 1 - p;
-  
-  // linear size of approximation
-  int final_Mx = pow(subdivision,n_approximations);
+  // (p_list is in descending order, so that p_turning_black is in ascending order)
+  std::vector<double> p_turning_black(p_list.size());
+  for(unsigned pi = 0; pi < p_list.size(); pi++)
+    p_turning_black[pi] = 1 - p_list[pi];
 
-  double mean_actual_chi = 0;
-  double std_error_actual_chi = 0;
-
-  for(unsigned run = 0; run < N_runs; run++){
-    BinField<bool> final_approximation(final_Mx, false);
+  CounterRNG rng(seed, run);
 
+  if(all_levels){
+    // refine one realization level by level, starting from the surviving unit square;
+    // the final approximation is the same realization as drawn by the tree walk below
     for(unsigned k = 1; k <= n_approximations; k++){
-      int tmp_size = pow(subdivision,k);
-      BinField<bool> tmp_Bernoulli(tmp_size,false);
-      RandomBernoulliBinField_const_p(tmp_Bernoulli, p_turning_black, seed);
-
-      for(int xi = 0; xi < tmp_size; xi++)
-        for(int yi = 0; yi < tmp_size; yi++)
-          if(tmp_Bernoulli.call(xi,yi)){ // if cell dies
-            // how many small pixels in final approximation
-            // correspond to one pixel in this k-th approximation?
-            int h = pow(subdivision,n_approximations-k);
-
-            // in the k-th approximation a square is set to false
-            // all offsprings die in final_approximation
-            for(int final_xi = xi*h; final_xi < (xi+1)*h; final_xi++)
-              for(int final_yi = yi*h; final_yi < (yi+1)*h; final_yi++)
-                final_approximation.assign(final_xi,final_yi,true);
-          }
-        
-    }// for all approximations
-
-    // compute euler characteristic of dead cells
-    // we apply white boundary conditions, that is surrounding is alive
-    // we connect dead cells
-    int chi_dead_times_eight = euler_wbc_pix(final_approximation);
-    if(chi_dead_times_eight%8 != 0)
+      RefineFractalPercolationBinField(approximations_[k-1], approximations_[k], subdivision, k, p_turning_black[0], rng);
+      observables[k-1] = surviving_euler_characteristic(approximations_[k]);
+    }
+  }
+  else if(evaluate_along_tree){
+    // only the sides of the surviving cells along the current path of the tree are stored
+    MinkowskiValuesPix values = FractalPercolationMinkowskiPix(subdivision, n_approximations, p_turning_black[0], rng, false);
+    if(values.euler%8 != 0)
       std::cerr << "Error: non-integer Euler characteristic" << std::endl;
 
-    // The Euler characteristic of the surviving Mandelbrot cells
-    int actual_chi = - chi_dead_times_eight/8;
-
-    /*
-    std::stringstream outputfigstst;
-    outputfigstst << "example-mandelbrot-subdivision" << subdivision << "-p" << p << "-S" << n_approximations << ".dat";
-    final_approximation.fout(outputfigstst.str().c_str(),prefix_of);
-    */
-
-    mean_actual_chi += actual_chi;
-    std_error_actual_chi += pow(actual_chi,2);
+    observables[0] = -values.euler/8;
+  }
+  else{
+    // the rows of the final approximation are drawn one after the other from the
+    // surviving cells of their ancestors and fed straight into the Minkowski accumulator,
+    // so that only O(subdivision^n_approximations) pixels are stored;
+    // a sweep yields the rows at all p_list at once
+    FractalPercolationRows rows(subdivision, n_approximations, p_turning_black, rng, false);
+    std::vector<EulerWbcPixRows> accumulators(p_list.size(), EulerWbcPixRows(rows.call_Nw()));
+    for(unsigned yi = 0; yi < rows.call_Nx(); yi++){
+      const uint64_t *row = rows.row(yi);
+      for(unsigned pi = 0; pi < p_list.size(); pi++)
+        accumulators[pi].add_row(row + pi*rows.call_Nw());
+    }
+
+    for(unsigned pi = 0; pi < p_list.size(); pi++){
+      int chi_times_eight = accumulators[pi].euler();
+      if(chi_times_eight%8 != 0)
+        std::cerr << "Error: non-integer Euler characteristic" << std::endl;
+
+      observables[pi] = -chi_times_eight/8;
+    }
   }
 
-  std_error_actual_chi = sqrt((std_error_actual_chi - pow(mean_actual_chi,2)/N_runs)/N_runs/(N_runs-1));
-  mean_actual_chi /= N_runs;
+  /*
+  std::stringstream outputfigstst;
+  outputfigstst << "example-mandelbrot-subdivision" << subdivision << "-p" << p << "-S" << n_approximations << ".dat";
+  approximations_.back().fout(outputfigstst.str().c_str(),prefix_of);
+  */
+}
 
-  std::stringstream outputstst;
-  outputstst << prefix_of << "frac-perc-mink-val-NN-" << subdivision << "x" << subdivision << "-n-" << n_approximations << "-p-" << std::setprecision(2) << p << ".dat";
-  std::ofstream output(outputstst.str().c_str());
-  output << p << " " << mean_actual_chi*pow(1./pow(subdivision,2)/p,n_approximations) << " " << std_error_actual_chi*pow(1./pow(subdivision,2)/p,n_approximations) << " " << n_approximations << std::endl;
-  output.close();
 
-  return 0;
+unsigned level(const unsigned &li)
+{
+  return all_levels ? li+1 : n_approximations;
 }
 
+
+int surviving_euler_characteristic(const BinField<bool> &approximation)
+{
+  // compute euler characteristic of dead cells
+  // we apply white boundary conditions, that is surrounding is alive
+  // we connect dead cells
+  int chi_dead_times_eight = euler_wbc_pix(approximation);
+  if(chi_dead_times_eight%8 != 0)
+    std::cerr << "Error: non-integer Euler characteristic" << std::endl;
+
+  // The Euler characteristic of the surviving Mandelbrot cells
+  return - chi_dead_times_eight/8;
+}
@@ -5,8 +5,28 @@
  *      Author: mklatt
  */
 
+#include <limits>
+#include <set>
+#include <sstream>
+
 #include "aux.h"
 
+unsigned DistinctPrecision(const std::vector<double> &values, const unsigned &min_precision)
+{
+  unsigned precision = min_precision;
+  for(; precision < unsigned(std::numeric_limits<double>::max_digits10); precision++){
+    std::set<std::string> printed;
+    for(unsigned i = 0; i < values.size(); i++){
+      std::stringstream value;
+      value << std::setprecision(precision) << values[i];
+      printed.insert(value.str());
+    }
+    if(printed.size() == std::set<double>(values.begin(), values.end()).size())
+      break;
+  }
+  return precision;
+}
+
 bool Cout_One_Percent(const unsigned int &i, unsigned int &p, const unsigned int &N){
 
   if(N < 100){
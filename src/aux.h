@@ -14,11 +14,34 @@
 #include <vector>
 #include <cstdlib>
 #include <stdarg.h>
+#include <stdint.h>
 
 const std::string PercentageBar = "0_____________________0.25_____________________0.50_____________________0.75_______________________1";
 /// Print progress of PercentageBar at position i in loop over 0...N-1
 bool Cout_One_Percent(const unsigned int &i, unsigned int &p, const unsigned int &N);
 
+/// Number of true bits in a 64-bit word
+inline int popcount(const uint64_t &word)
+{
+  return __builtin_popcountll(word);
+}
+
+/// Index of the lowest true bit in a non-zero 64-bit word
+inline int lowest_bit(const uint64_t &word)
+{
+  return __builtin_ctzll(word);
+}
+
+/// Index of the highest true bit in a non-zero 64-bit word
+inline int highest_bit(const uint64_t &word)
+{
+  return 63 - __builtin_clzll(word);
+}
+
+/// Smallest precision (at least min_precision) at which all values are printed differently,
+/// e.g., to tell apart the output files of a list of parameters
+unsigned DistinctPrecision(const std::vector<double> &values, const unsigned &min_precision = 2);
+
 template < typename number >
 /// Sum of entries in vector
 number sum(const std::vector<number> &oughttobesummed)
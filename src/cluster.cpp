@@ -0,0 +1,947 @@
+/*
+ * cluster.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#include "cluster.h"
+#include "minkowski.h"
+
+#include <atomic>
+#include <thread>
+
+// Root of the provisional label l (with path halving)
+static int find_root(std::vector<int> &parent, int l)
+{
+  while(parent[l] != l){
+    parent[l] = parent[parent[l]];
+    l = parent[l];
+  }
+  return l;
+}
+
+// Merge the trees of the provisional labels l and m; returns the common root
+static int merge_labels(std::vector<int> &parent, const int &l, const int &m)
+{
+  int root_l = find_root(parent, l);
+  int root_m = find_root(parent, m);
+  if(root_l < root_m){
+    parent[root_m] = root_l;
+    return root_l;
+  }
+  parent[root_l] = root_m;
+  return root_m;
+}
+
+
+// Label the columns start_x...end_x-1 of bw (the columns outside are taken to be dead) with
+// provisional labels, which are merged in parent; then the provisional labels are mapped
+// to consecutive labels 1...N_clusters of the strip by cluster, and N_clusters is returned
+template < typename connectivity >
+static int label_strip(const BinField<bool> &bw, BinField<int> &labels,
+                       const unsigned &start_x, const unsigned &end_x, std::vector<int> &cluster)
+{
+  unsigned Ny = bw.call_Ny();
+
+  // parent[l] of the provisional label l (label 0 = "dead/black/true")
+  std::vector<int> parent(1, 0);
+
+  for(unsigned xi = start_x; xi < end_x; xi++)
+    for(unsigned yi = 0; yi < Ny; yi++){
+      if(bw.call(xi,yi)){
+        labels.assign(xi,yi, 0);
+        continue;
+      }
+
+      // labels of the surviving neighbors that have already been visited: yi-reach...yi+reach
+      // in the column to the left and the pixel below
+      // BOUNDARY CONDITION: DEAD
+      int neighbors[2*connectivity::reach + 2];
+      unsigned N_neighbors = 0;
+      if(xi > start_x)
+        for(int dy = -connectivity::reach; dy <= connectivity::reach; dy++)
+          if(int(yi)+dy >= 0 && int(yi)+dy < int(Ny) && !bw.call(xi-1,yi+dy))
+            neighbors[N_neighbors++] = labels.call(xi-1,yi+dy);
+      if(yi > 0 && !bw.call(xi,yi-1))
+        neighbors[N_neighbors++] = labels.call(xi,yi-1);
+
+      if(N_neighbors == 0){ // new label
+        parent.push_back(parent.size());
+        labels.assign(xi,yi, parent.size()-1);
+        continue;
+      }
+      int label = neighbors[0];
+      for(unsigned ni = 1; ni < N_neighbors; ni++)
+        if(neighbors[ni] != label)
+          label = merge_labels(parent, label, neighbors[ni]);
+      labels.assign(xi,yi, label);
+    }
+
+  // consecutive labels of the roots
+  cluster.assign(parent.size(), 0);
+  int N_clusters = 0;
+  for(unsigned l = 1; l < parent.size(); l++){
+    int root = find_root(parent, l);
+    if(root == int(l))
+      cluster[l] = ++N_clusters;
+    else
+      cluster[l] = cluster[root];
+  }
+  return N_clusters;
+}
+
+// Replace the labels l of the columns start_x...end_x-1 by cluster[l]
+static void relabel_strip(BinField<int> &labels, const unsigned &start_x, const unsigned &end_x,
+                          const std::vector<int> &cluster)
+{
+  for(unsigned xi = start_x; xi < end_x; xi++)
+    for(unsigned yi = 0; yi < labels.call_Ny(); yi++)
+      labels.assign(xi,yi, cluster[labels.call(xi,yi)]);
+}
+
+// Concurrent union-find: roots are only linked by compare-and-swap, always the larger
+// label below the smaller one, so that the root of a cluster is its smallest label
+static int find_root(const std::vector< std::atomic<int> > &parent, int l)
+{
+  while(parent[l].load() != l)
+    l = parent[l].load();
+  return l;
+}
+
+static void merge_labels(std::vector< std::atomic<int> > &parent, int l, int m)
+{
+  while(true){
+    l = find_root(parent, l);
+    m = find_root(parent, m);
+    if(l == m)
+      return;
+    if(l < m)
+      std::swap(l, m);
+    int expected = l;
+    if(parent[l].compare_exchange_strong(expected, m))
+      return;
+  }
+}
+
+// Merge the clusters of the strips that touch along the seam between the columns xi-1 and xi,
+// where the label of a pixel is offset[strip] + cluster[strip][provisional label]
+template < typename connectivity >
+static void merge_seam(const BinField<bool> &bw, const BinField<int> &labels, const unsigned &xi, const int &offset_left, const std::vector<int> &cluster_left,
+                       const int &offset_right, const std::vector<int> &cluster_right,
+                       std::vector< std::atomic<int> > &parent)
+{
+  unsigned Ny = bw.call_Ny();
+  for(unsigned yi = 0; yi < Ny; yi++){
+    if(bw.call(xi,yi))
+      continue;
+    const int label = offset_right + cluster_right[labels.call(xi,yi)];
+    for(int dy = -connectivity::reach; dy <= connectivity::reach; dy++){
+      if(int(yi)+dy < 0 || int(yi)+dy >= int(Ny) || bw.call(xi-1,yi+dy))
+        continue;
+      merge_labels(parent, label, offset_left + cluster_left[labels.call(xi-1,yi+dy)]);
+    }
+  }
+}
+
+
+template < typename connectivity >
+int LabelSurvivingClusters(const BinField<bool> &bw, BinField<int> &labels, const unsigned &N_threads)
+{
+  unsigned Nx = bw.call_Nx();
+  unsigned Ny = bw.call_Ny();
+  if(labels.call_Nx() != Nx || labels.call_Ny() != Ny){
+    std::cerr << "ERROR: LabelSurvivingClusters recieved " << labels.call_Nx() << " x " << labels.call_Ny()
+              << " labels for " << Nx << " x " << Ny << " pixels;" << std::endl;
+    exit(-1);
+  }
+
+  unsigned N_strips = N_threads;
+  if(N_strips == 0)
+    N_strips = std::max(1u, std::thread::hardware_concurrency());
+  N_strips = std::max(1u, std::min(N_strips, Nx/2));
+
+  if(N_strips == 1){
+    std::vector<int> cluster;
+    int N_clusters = label_strip<connectivity>(bw, labels, 0, Nx, cluster);
+    relabel_strip(labels, 0, Nx, cluster);
+    return N_clusters;
+  }
+
+  // strip si: columns start_x[si]...start_x[si+1]-1
+  std::vector<unsigned> start_x(N_strips+1);
+  for(unsigned si = 0; si <= N_strips; si++)
+    start_x[si] = (unsigned long)(Nx)*si/N_strips;
+
+  // label the strips independently
+  std::vector< std::vector<int> > cluster(N_strips);
+  std::vector<int> N_clusters_of_strip(N_strips, 0);
+  std::vector<std::thread> pool;
+  for(unsigned si = 0; si < N_strips; si++)
+    pool.push_back(std::thread([&, si] {
+      N_clusters_of_strip[si] = label_strip<connectivity>(bw, labels, start_x[si], start_x[si+1], cluster[si]);
+    }));
+  for(unsigned si = 0; si < N_strips; si++)
+    pool[si].join();
+  pool.clear();
+
+  // the clusters of the strip si are offset[si]+1...offset[si+1], in the order of the scan
+  std::vector<int> offset(N_strips+1, 0);
+  for(unsigned si = 0; si < N_strips; si++)
+    offset[si+1] = offset[si] + N_clusters_of_strip[si];
+
+  // merge the seams concurrently
+  std::vector< std::atomic<int> > parent(offset[N_strips]+1);
+  for(unsigned l = 0; l < parent.size(); l++)
+    parent[l].store(l);
+  for(unsigned si = 1; si < N_strips; si++)
+    pool.push_back(std::thread([&, si] {
+      merge_seam<connectivity>(bw, labels, start_x[si], offset[si-1], cluster[si-1], offset[si], cluster[si], parent);
+    }));
+  for(unsigned si = 1; si < N_strips; si++)
+    pool[si-1].join();
+  pool.clear();
+
+  // consecutive labels of the roots, which are the smallest labels of their clusters,
+  // so that the labels are the same as for a single strip
+  std::vector<int> global_cluster(parent.size(), 0);
+  int N_clusters = 0;
+  for(unsigned l = 1; l < parent.size(); l++){
+    int root = find_root(parent, l);
+    if(root == int(l))
+      global_cluster[l] = ++N_clusters;
+    else
+      global_cluster[l] = global_cluster[root];
+  }
+  for(unsigned si = 0; si < N_strips; si++)
+    for(unsigned l = 1; l < cluster[si].size(); l++)
+      cluster[si][l] = global_cluster[offset[si] + cluster[si][l]];
+
+  for(unsigned si = 0; si < N_strips; si++)
+    pool.push_back(std::thread(relabel_strip, std::ref(labels), start_x[si], start_x[si+1], std::cref(cluster[si])));
+  for(unsigned si = 0; si < N_strips; si++)
+    pool[si].join();
+
+  return N_clusters;
+}
+
+// -------------------------
+// Minkowski functionals of single clusters
+// -------------------------
+
+static const MinkowskiValuesPix NoFunctionals = { 0, 0, 0 };
+
+static inline void AddFunctionals (MinkowskiValuesPix &sum, const MinkowskiValuesPix &values)
+{
+  sum.area += values.area;
+  sum.perimeter += values.perimeter;
+  sum.euler += values.euler;
+}
+
+// Contributions (times 8) of a window to the functionals of a cluster, functionals[inside][cluster]
+// as for PercolatingClusterRows, which are filled once per connectivity
+template < typename connectivity >
+struct ClusterWindows {
+  MinkowskiValuesPix functionals[16][16];
+
+  ClusterWindows()
+  {
+    for(unsigned inside = 0; inside < 16; inside++)
+      for(unsigned cluster = 0; cluster < 16; cluster++){
+        MinkowskiValuesPix &window = functionals[inside][cluster];
+        window.area = rg5_area_pix.at(cluster);
+        window.perimeter = rg5_perimeter_pix.at(cluster);
+        window.euler = connectivity::euler_of_window(inside, cluster);
+      }
+  }
+};
+
+template < typename connectivity >
+static const MinkowskiValuesPix (&ClusterFunctionalsOfWindow ())[16][16]
+{
+  static const ClusterWindows<connectivity> windows;
+  return windows.functionals;
+}
+
+// Add the contributions of N_windows windows with the same configuration to the clusters of their pixels,
+// where roots are the labels of the roots of the right_low, left_low, right_up, and left_up pixel (0 = dead or outside)
+static inline void AddWindowToClusters (const int roots[4], const MinkowskiValuesPix functionals_of_window[16],
+                                        std::vector<MinkowskiValuesPix> &functionals, const long &N_windows = 1)
+{
+  for(unsigned ci = 0; ci < 4; ci++){
+    if(roots[ci] == 0)
+      continue;
+    bool counted = false;
+    for(unsigned cj = 0; cj < ci; cj++)
+      counted = counted || roots[cj] == roots[ci];
+    if(counted)
+      continue;
+    const unsigned cluster = convert(roots[0] == roots[ci], roots[1] == roots[ci], roots[2] == roots[ci], roots[3] == roots[ci]);
+    MinkowskiValuesPix &sum = functionals[roots[ci]];
+    sum.area += N_windows*functionals_of_window[cluster].area;
+    sum.perimeter += N_windows*functionals_of_window[cluster].perimeter;
+    sum.euler += N_windows*functionals_of_window[cluster].euler;
+  }
+}
+
+// Record a complete cluster with functionals (times 8, including the Euler characteristic
+// of the sample without any cluster) in clusters
+static void CloseCluster (SurvivingClusterFunctionals &clusters, const MinkowskiValuesPix &cluster, const bool &percolating)
+{
+  if(cluster.euler%8 != 0)
+    std::cerr << "Error: non-integer Euler characteristic" << std::endl;
+  AddFunctionals(clusters.all, cluster);
+  const MinkowskiValuesPix &largest = clusters.largest;
+  if(cluster.area > largest.area ||
+     (cluster.area == largest.area && (cluster.perimeter > largest.perimeter ||
+                                       (cluster.perimeter == largest.perimeter && cluster.euler > largest.euler))))
+    clusters.largest = cluster;
+  if(percolating){
+    clusters.percolates = true;
+    clusters.percolating = cluster;
+  }
+}
+
+// No clusters yet
+static void ResetClusters (SurvivingClusterFunctionals &clusters)
+{
+  clusters.percolates = false;
+  clusters.percolating = NoFunctionals;
+  clusters.largest = NoFunctionals;
+  clusters.all = NoFunctionals;
+}
+
+
+// -------------------------
+// Cluster sizes
+// -------------------------
+
+static const ClusterMoments NoMoments = { 0, 0, 0, 0 };
+
+static inline void AddMoments (ClusterMoments &sum, const ClusterMoments &values)
+{
+  sum.size += values.size;
+  sum.sum_x += values.sum_x;
+  sum.sum_y += values.sum_y;
+  sum.sum_squares += values.sum_squares;
+}
+
+ClusterSizeDistribution::ClusterSizeDistribution(const unsigned long &max_size) :
+histogram_ ( std::vector<long> (highest_bit(std::max(max_size, 1ul))+1, 0) )
+{
+  clear();
+}
+
+void ClusterSizeDistribution::clear()
+{
+  std::fill(histogram_.begin(), histogram_.end(), 0);
+  N_clusters_ = 0;
+  sum_size_ = 0;
+  sum_size_squared_ = 0;
+  sum_size_squared_radius_squared_ = 0;
+}
+
+void ClusterSizeDistribution::add(const ClusterMoments &cluster)
+{
+  const unsigned bi = highest_bit(cluster.size);
+  if(bi >= histogram_.size()){
+    std::cerr << "ERROR: ClusterSizeDistribution recieved a cluster of " << cluster.size << " pixels;" << std::endl;
+    exit(-1);
+  }
+  histogram_[bi]++;
+  N_clusters_++;
+
+  const double s = cluster.size;
+  sum_size_ += s;
+  sum_size_squared_ += s*s;
+  // s^2 R^2 = s sum (x^2 + y^2) - (sum x)^2 - (sum y)^2
+  sum_size_squared_radius_squared_ += s*double(cluster.sum_squares) - double(cluster.sum_x)*double(cluster.sum_x)
+                                                                    - double(cluster.sum_y)*double(cluster.sum_y);
+}
+
+
+// -------------------------
+// Streaming labeling
+// -------------------------
+
+void SurvivingRuns(const uint64_t *row, const unsigned &Nx, std::vector<SurvivingRun> &runs)
+{
+  runs.clear();
+  const unsigned Nw = (Nx+63)/64;
+
+  // a run starts or ends (plus one) wherever a pixel differs from its left neighbor
+  bool in_run = false;
+  SurvivingRun run = { 0, 0 };
+  uint64_t carry = 0;
+  for(unsigned wi = 0; wi < Nw; wi++){
+    uint64_t alive = ~row[wi];
+    if(wi == Nw-1 && Nx % 64 != 0)
+      alive &= (uint64_t(1) << (Nx % 64)) - 1;
+    uint64_t changes = alive ^ ((alive << 1) | carry);
+    carry = alive >> 63;
+    for(; changes != 0; changes &= changes-1){
+      const unsigned xi = wi*64 + lowest_bit(changes);
+      if(in_run){
+        run.end = xi-1;
+        runs.push_back(run);
+      }
+      else
+        run.start = xi;
+      in_run = !in_run;
+    }
+  }
+  if(in_run){
+    run.end = Nx-1;
+    runs.push_back(run);
+  }
+}
+
+
+template < typename connectivity >
+PercolatingClusterRows<connectivity>::PercolatingClusterRows(const unsigned &Nx, const unsigned &Ny) :
+Nx_ ( Nx ), Ny_ ( Ny ), yi_ ( 0 ), functionals_of_window_ ( ClusterFunctionalsOfWindow<connectivity>() ),
+parent_ ( std::vector<int> (1, 0) ), touches_ ( std::vector<unsigned> (1, 0) ),
+functionals_ ( std::vector<MinkowskiValuesPix> (1, NoFunctionals) ),
+moments_ ( std::vector<ClusterMoments> (1, NoMoments) ), sizes_ ( 0 )
+{
+  ResetClusters(clusters_);
+}
+
+template < typename connectivity >
+int PercolatingClusterRows<connectivity>::find_root(int l)
+{
+  while(parent_[l] != l){
+    parent_[l] = parent_[parent_[l]];
+    l = parent_[l];
+  }
+  return l;
+}
+
+template < typename connectivity >
+int PercolatingClusterRows<connectivity>::merge(const int &l, const int &m)
+{
+  int root_l = find_root(l);
+  int root_m = find_root(m);
+  if(root_l == root_m)
+    return root_l;
+  if(root_l > root_m)
+    std::swap(root_l, root_m);
+  parent_[root_m] = root_l;
+  touches_[root_l] |= touches_[root_m];
+  AddFunctionals(functionals_[root_l], functionals_[root_m]);
+  AddMoments(moments_[root_l], moments_[root_m]);
+  return root_l;
+}
+
+template < typename connectivity >
+int PercolatingClusterRows<connectivity>::new_label(const unsigned &touches)
+{
+  parent_.push_back(parent_.size());
+  touches_.push_back(touches);
+  functionals_.push_back(NoFunctionals);
+  moments_.push_back(NoMoments);
+  return parent_.size()-1;
+}
+
+template < typename connectivity >
+void PercolatingClusterRows<connectivity>::add_row(const uint64_t *row)
+{
+  if(yi_ >= Ny_){
+    std::cerr << "ERROR: PercolatingClusterRows recieved more than " << Ny_ << " rows;" << std::endl;
+    exit(-1);
+  }
+
+  std::swap(previous_runs_, current_runs_);
+  std::swap(previous_labels_, current_labels_);
+  std::swap(previous_ends_, current_ends_);
+  SurvivingRuns(row, Nx_, current_runs_);
+
+  const std::vector<SurvivingRun> &below = previous_runs_;
+  const std::vector<SurvivingRun> &runs = current_runs_;
+  std::vector<int> &labels = current_labels_;
+  labels.resize(runs.size());
+  current_ends_.clear();
+
+  // BOUNDARY CONDITION: DEAD
+  const int reach = connectivity::reach;
+  unsigned first_below = 0;
+  for(unsigned ri = 0; ri < runs.size(); ri++){
+    const SurvivingRun &run = runs[ri];
+    current_ends_.push_back(run.start);
+    current_ends_.push_back(run.end+1);
+
+    unsigned touches = 0;
+    if(run.start == 0)     touches |= LEFT;
+    if(run.end == Nx_-1)   touches |= RIGHT;
+    if(yi_ == 0)           touches |= BOTTOM;
+    if(yi_ == Ny_-1)       touches |= TOP;
+
+    // runs below that overlap with start-reach...end+reach
+    while(first_below < below.size() && int(below[first_below].end) + reach < int(run.start))
+      first_below++;
+    int label = 0;
+    for(unsigned bi = first_below; bi < below.size() && int(below[bi].start) <= int(run.end) + reach; bi++)
+      label = label == 0 ? find_root(previous_labels_[bi]) : merge(label, previous_labels_[bi]);
+
+    if(label == 0)
+      label = new_label(touches);
+    else
+      touches_[label] |= touches;
+    labels[ri] = label;
+
+    // pixels start...end of the row yi
+    const long start = run.start, end = run.end, length = end - start + 1;
+    ClusterMoments &moments = moments_[label];
+    moments.size += length;
+    moments.sum_x += (start + end)*length/2;
+    moments.sum_y += length*yi_;
+    moments.sum_squares += (end*(end+1)*(2*end+1) - (start-1)*start*(2*start-1))/6 + length*yi_*yi_;
+  }
+
+  add_windows(yi_ > 0, true);
+  yi_++;
+
+  if(yi_ < Ny_)
+    compact();
+  else{
+    // the windows above the top row complete all clusters
+    std::swap(previous_runs_, current_runs_);
+    std::swap(previous_labels_, current_labels_);
+    std::swap(previous_ends_, current_ends_);
+    current_runs_.clear();
+    current_labels_.clear();
+    current_ends_.clear();
+    add_windows(true, false);
+    for(unsigned l = 1; l < parent_.size(); l++)
+      if(find_root(l) == int(l))
+        close_cluster(l);
+  }
+}
+
+template < typename connectivity >
+int PercolatingClusterRows<connectivity>::label_of_pixel(const std::vector<SurvivingRun> &runs, const std::vector<int> &labels,
+                                                         unsigned &ri, const unsigned &xi) const
+{
+  while(ri < runs.size() && runs[ri].end < xi)
+    ri++;
+  if(ri < runs.size() && runs[ri].start <= xi)
+    return labels[ri];
+  return 0;
+}
+
+template < typename connectivity >
+void PercolatingClusterRows<connectivity>::add_windows(const bool &low_inside, const bool &up_inside)
+{
+  // the window X covers the pixels xi = X-1 and xi = X; its configuration can only differ
+  // from the one of the window X-1 if a run of either row starts or ends (plus one) at X.
+  // The windows in between have the same left and right pixels, which only contribute to the
+  // area and perimeter, and are added at once.
+  windows_.resize(previous_ends_.size() + current_ends_.size());
+  std::merge(previous_ends_.begin(), previous_ends_.end(), current_ends_.begin(), current_ends_.end(), windows_.begin());
+  windows_.erase(std::unique(windows_.begin(), windows_.end()), windows_.end());
+  const unsigned inside_between = convert(low_inside, low_inside, up_inside, up_inside);
+
+  unsigned low_ri = 0, up_ri = 0;
+  for(unsigned wi = 0; wi < windows_.size(); wi++){
+    const unsigned X = windows_[wi];
+
+    const bool left = X > 0, right = X < Nx_;
+    const unsigned inside = convert(low_inside && right, low_inside && left, up_inside && right, up_inside && left);
+
+    // roots of the right_low, left_low, right_up, and left_up pixel
+    int roots[4] = { 0, 0, 0, 0 };
+    if(left){
+      roots[1] = label_of_pixel(previous_runs_, previous_labels_, low_ri, X-1);
+      roots[3] = label_of_pixel(current_runs_, current_labels_, up_ri, X-1);
+    }
+    if(right){
+      roots[0] = label_of_pixel(previous_runs_, previous_labels_, low_ri, X);
+      roots[2] = label_of_pixel(current_runs_, current_labels_, up_ri, X);
+    }
+    for(unsigned ci = 0; ci < 4; ci++)
+      if(roots[ci] != 0)
+        roots[ci] = find_root(roots[ci]);
+
+    AddWindowToClusters(roots, functionals_of_window_[inside], functionals_);
+
+    // the windows X+1...next_X-1 (beyond the last window, all pixels are dead)
+    if(wi+1 < windows_.size() && windows_[wi+1] > X+1 && (roots[0] != 0 || roots[2] != 0)){
+      const int roots_between[4] = { roots[0], roots[0], roots[2], roots[2] };
+      AddWindowToClusters(roots_between, functionals_of_window_[inside_between], functionals_, windows_[wi+1]-X-1);
+    }
+  }
+}
+
+template < typename connectivity >
+void PercolatingClusterRows<connectivity>::compact()
+{
+  std::vector<int> &labels = current_labels_;
+
+  new_index_.assign(parent_.size(), 0);
+  std::vector<int> parent(1, 0);
+  std::vector<unsigned> touches(1, 0);
+  std::vector<MinkowskiValuesPix> functionals(1, NoFunctionals);
+  std::vector<ClusterMoments> moments(1, NoMoments);
+
+  for(unsigned ri = 0; ri < labels.size(); ri++){
+    const int root = find_root(labels[ri]);
+    if(new_index_[root] == 0){
+      new_index_[root] = parent.size();
+      parent.push_back(parent.size());
+      touches.push_back(touches_[root]);
+      functionals.push_back(functionals_[root]);
+      moments.push_back(moments_[root]);
+    }
+    labels[ri] = new_index_[root];
+  }
+
+  // clusters that do not reach into the current row are complete
+  for(unsigned l = 1; l < parent_.size(); l++)
+    if(parent_[l] == int(l) && new_index_[l] == 0)
+      close_cluster(l);
+
+  parent_.swap(parent);
+  touches_.swap(touches);
+  functionals_.swap(functionals);
+  moments_.swap(moments);
+}
+
+template < typename connectivity >
+void PercolatingClusterRows<connectivity>::close_cluster(const int &root)
+{
+  MinkowskiValuesPix cluster = functionals_[root];
+  cluster.euler += connectivity::euler_of_sample;
+  const bool percolating = touches_[root] == (LEFT | RIGHT | BOTTOM | TOP);
+  CloseCluster(clusters_, cluster, percolating);
+  if(sizes_ && !percolating)
+    sizes_->add(moments_[root]);
+}
+
+
+// -------------------------
+// Percolation along the subdivision tree
+// -------------------------
+
+// Boundary summary of a surviving cell: the labels of the surviving clusters of its pixels
+// along the four sides (bottom and top from left to right, left and right from bottom to top;
+// 0 = dead) and the functionals (times 8) of the windows inside of the cell for
+// each of the labels 1...N_labels
+struct ClusterSummary {
+  std::vector<int> bottom, top, left, right;
+  std::vector<MinkowskiValuesPix> functionals;
+};
+
+// Parameters and workspaces of the tree walk: the summaries of the children
+// of the current cell in the k-th approximation are children[k][cx*subdivision+cy]
+struct ClusterWalk {
+  unsigned subdivision, n_approximations;
+  double p_turning_black;
+  std::vector<unsigned> h;
+  std::vector< std::vector<ClusterSummary> > children;
+  const MinkowskiValuesPix (*functionals_of_window)[16];
+  int euler_of_sample;
+  // the complete clusters
+  SurvivingClusterFunctionals clusters;
+  // union-find forest of the labels of the children (label offset[ci]+l of child ci), and
+  // the labels of the roots in the summary of the cell; offset also holds the labels of
+  // the pixels of a cell in the (n_approximations-1)-th approximation
+  std::vector<int> offset;
+  std::vector<int> parent;
+  std::vector<MinkowskiValuesPix> functionals;
+  std::vector<int> new_label;
+};
+
+static int FindRoot (std::vector<int> &parent, int l)
+{
+  while(parent[l] != l){
+    parent[l] = parent[parent[l]];
+    l = parent[l];
+  }
+  return l;
+}
+
+static void Unite (std::vector<int> &parent, const int &l, const int &m)
+{
+  if(l == 0 || m == 0)
+    return;
+  int root_l = FindRoot(parent, l);
+  int root_m = FindRoot(parent, m);
+  if(root_l < root_m)
+    parent[root_m] = root_l;
+  else if(root_m < root_l)
+    parent[root_l] = root_m;
+}
+
+// Label of a child in the forest of its parent (0 = dead)
+static inline int Offset (const int &label, const int &offset)
+{
+  return label ? offset + label : 0;
+}
+
+// Window across a seam between children; labels of the right_low, left_low, right_up, and left_up pixel
+// (already offset, 0 = dead): either merge the clusters connected within the window, or add its
+// contributions to the functionals of the roots
+template < typename connectivity >
+static inline void SeamWindow (ClusterWalk &walk, const bool &unite,
+                               const int &right_low, const int &left_low, const int &right_up, const int &left_up)
+{
+  if(right_low == 0 && left_low == 0 && right_up == 0 && left_up == 0)
+    return;
+  if(unite){
+    Unite(walk.parent, left_low, right_low);
+    Unite(walk.parent, left_up, right_up);
+    Unite(walk.parent, left_low, left_up);
+    Unite(walk.parent, right_low, right_up);
+    if(connectivity::reach > 0){
+      Unite(walk.parent, left_low, right_up);
+      Unite(walk.parent, right_low, left_up);
+    }
+    return;
+  }
+  int roots[4] = { right_low, left_low, right_up, left_up };
+  for(unsigned ci = 0; ci < 4; ci++)
+    if(roots[ci] != 0)
+      roots[ci] = FindRoot(walk.parent, roots[ci]);
+  AddWindowToClusters(roots, walk.functionals_of_window[15], walk.functionals);
+}
+
+// Relabel the sides of cell, which hold labels of the forest of walk, by the roots that reach
+// them, and collect the functionals of their clusters; the other clusters are complete
+static void RelabelSides (ClusterWalk &walk, ClusterSummary &cell)
+{
+  std::vector<int> &parent = walk.parent;
+  std::vector<MinkowskiValuesPix> &functionals = walk.functionals;
+  std::vector<int> &new_label = walk.new_label;
+  new_label.assign(parent.size(), 0);
+  cell.functionals.assign(1, NoFunctionals);
+
+  std::vector<int>* sides[4] = { &cell.bottom, &cell.top, &cell.left, &cell.right };
+  for(unsigned side = 0; side < 4; side++)
+    for(unsigned i = 0; i < sides[side]->size(); i++){
+      int &label = (*sides[side])[i];
+      if(label == 0)
+        continue;
+      const int root = FindRoot(parent, label);
+      if(new_label[root] == 0){
+        new_label[root] = cell.functionals.size();
+        cell.functionals.push_back(NoFunctionals);
+      }
+      label = new_label[root];
+    }
+
+  // the roots are the smallest labels of their trees
+  for(unsigned l = 1; l < parent.size(); l++){
+    const int root = FindRoot(parent, l);
+    if(root != int(l))
+      AddFunctionals(functionals[root], functionals[l]);
+  }
+  for(unsigned l = 1; l < parent.size(); l++){
+    if(parent[l] != int(l))
+      continue;
+    if(new_label[l] != 0)
+      cell.functionals[new_label[l]] = functionals[l];
+    else if(functionals[l].area != 0){ // a surviving cluster that does not reach the sides
+      MinkowskiValuesPix cluster = functionals[l];
+      cluster.euler += walk.euler_of_sample;
+      CloseCluster(walk.clusters, cluster, false);
+    }
+  }
+}
+
+// Summary of the surviving cell (xi,yi) in the k-th approximation, glued from the summaries
+// of its children along the windows across the seams between the children
+template < typename connectivity >
+static void SummarizeSurvivingClusters (ClusterWalk &walk, const CounterRNG &rng, const unsigned &k,
+                                        const unsigned &xi, const unsigned &yi, ClusterSummary &cell)
+{
+  if(k == walk.n_approximations){
+    // a single surviving pixel
+    cell.bottom.assign(1, 1);
+    cell.top.assign(1, 1);
+    cell.left.assign(1, 1);
+    cell.right.assign(1, 1);
+    cell.functionals.assign(2, NoFunctionals);
+    return;
+  }
+
+  const unsigned M = walk.subdivision;
+  const unsigned hc = walk.h[k+1];
+  const unsigned h = walk.h[k];
+  std::vector<int> &parent = walk.parent;
+  std::vector<MinkowskiValuesPix> &functionals = walk.functionals;
+  cell.bottom.resize(h);
+  cell.top.resize(h);
+  cell.left.resize(h);
+  cell.right.resize(h);
+
+  // children are single pixels: the surviving pixel (cx,cy) is the label cx*M+cy+1
+  if(hc == 1){
+    std::vector<int> &pixels = walk.offset;
+    pixels.resize(M*M);
+    for(unsigned cx = 0; cx < M; cx++)
+      for(unsigned cy = 0; cy < M; cy++)
+        pixels[cx*M+cy] = ( rng.uniform(k+1, xi*M+cx, yi*M+cy) < walk.p_turning_black ) ? 0 : cx*M+cy+1;
+
+    parent.resize(M*M+1);
+    functionals.assign(M*M+1, NoFunctionals);
+    for(unsigned l = 0; l < parent.size(); l++)
+      parent[l] = l;
+    for(unsigned pass = 0; pass < 2; pass++)
+      for(unsigned X = 0; X+1 < M; X++)
+        for(unsigned Y = 0; Y+1 < M; Y++)
+          SeamWindow<connectivity>(walk, pass == 0, pixels[(X+1)*M+Y], pixels[X*M+Y], pixels[(X+1)*M+Y+1], pixels[X*M+Y+1]);
+
+    for(unsigned ci = 0; ci < M; ci++){
+      cell.bottom[ci] = pixels[ci*M];
+      cell.top[ci] = pixels[ci*M + M-1];
+      cell.left[ci] = pixels[ci];
+      cell.right[ci] = pixels[(M-1)*M + ci];
+    }
+    RelabelSides(walk, cell);
+    return;
+  }
+
+  std::vector<ClusterSummary> &child = walk.children[k];
+  for(unsigned cx = 0; cx < M; cx++)
+    for(unsigned cy = 0; cy < M; cy++){
+      ClusterSummary &c = child[cx*M+cy];
+      if( rng.uniform(k+1, xi*M+cx, yi*M+cy) < walk.p_turning_black ){ // if cell dies
+        c.bottom.assign(hc, 0);
+        c.top.assign(hc, 0);
+        c.left.assign(hc, 0);
+        c.right.assign(hc, 0);
+        c.functionals.assign(1, NoFunctionals);
+      }
+      else
+        SummarizeSurvivingClusters<connectivity>(walk, rng, k+1, xi*M+cx, yi*M+cy, c);
+    }
+
+  // forest of the labels of all children
+  std::vector<int> &offset = walk.offset;
+  offset.assign(M*M+1, 0);
+  for(unsigned ci = 0; ci < M*M; ci++)
+    offset[ci+1] = offset[ci] + child[ci].functionals.size()-1;
+  parent.resize(offset[M*M]+1);
+  functionals.resize(offset[M*M]+1);
+  for(unsigned l = 0; l < parent.size(); l++)
+    parent[l] = l;
+  for(unsigned ci = 0; ci < M*M; ci++)
+    for(unsigned l = 1; l < child[ci].functionals.size(); l++)
+      functionals[offset[ci]+l] = child[ci].functionals[l];
+
+  // windows across the vertical seams, including the junctions of four children, and
+  // across the horizontal seams, without the junctions; first merging, then counting
+  for(unsigned pass = 0; pass < 2; pass++){
+    const bool unite = pass == 0;
+    for(unsigned cx = 0; cx+1 < M; cx++)
+      for(unsigned cy = 0; cy < M; cy++){
+        const unsigned ci = cx*M + cy, cj = (cx+1)*M + cy;
+        const std::vector<int> &left = child[ci].right, &right = child[cj].left;
+        for(unsigned y = 0; y+1 < hc; y++)
+          SeamWindow<connectivity>(walk, unite, Offset(right[y], offset[cj]), Offset(left[y], offset[ci]),
+                     Offset(right[y+1], offset[cj]), Offset(left[y+1], offset[ci]));
+        if(cy+1 < M){
+          const unsigned ci_up = cx*M + cy+1, cj_up = (cx+1)*M + cy+1;
+          SeamWindow<connectivity>(walk, unite, Offset(right[hc-1], offset[cj]), Offset(left[hc-1], offset[ci]),
+                     Offset(child[cj_up].left[0], offset[cj_up]), Offset(child[ci_up].right[0], offset[ci_up]));
+        }
+      }
+    for(unsigned cy = 0; cy+1 < M; cy++)
+      for(unsigned cx = 0; cx < M; cx++){
+        const unsigned ci = cx*M + cy, cj = cx*M + cy+1;
+        const std::vector<int> &low = child[ci].top, &up = child[cj].bottom;
+        for(unsigned x = 0; x+1 < hc; x++)
+          SeamWindow<connectivity>(walk, unite, Offset(low[x+1], offset[ci]), Offset(low[x], offset[ci]),
+                     Offset(up[x+1], offset[cj]), Offset(up[x], offset[cj]));
+      }
+  }
+
+  // sides of the cell
+  for(unsigned ci = 0; ci < M; ci++)
+    for(unsigned i = 0; i < hc; i++){
+      cell.bottom[ci*hc + i] = Offset(child[ci*M].bottom[i], offset[ci*M]);
+      cell.top[ci*hc + i] = Offset(child[ci*M + M-1].top[i], offset[ci*M + M-1]);
+      cell.left[ci*hc + i] = Offset(child[ci].left[i], offset[ci]);
+      cell.right[ci*hc + i] = Offset(child[(M-1)*M + ci].right[i], offset[(M-1)*M + ci]);
+    }
+  RelabelSides(walk, cell);
+}
+
+template < typename connectivity >
+bool FractalPercolationPercolatingCluster (const unsigned &subdivision, const unsigned &n_approximations,
+                                          const double &p_turning_black, const CounterRNG &rng,
+                                          SurvivingClusterFunctionals &clusters)
+{
+  ClusterWalk walk;
+  walk.subdivision = subdivision;
+  walk.n_approximations = n_approximations;
+  walk.p_turning_black = p_turning_black;
+  walk.h = BlockSizesPerLevel(subdivision, n_approximations);
+  walk.children.resize(n_approximations, std::vector<ClusterSummary>(subdivision*subdivision));
+  walk.functionals_of_window = ClusterFunctionalsOfWindow<connectivity>();
+  walk.euler_of_sample = connectivity::euler_of_sample;
+  ResetClusters(walk.clusters);
+
+  // the 0-th approximation (the unit square) always survives
+  ClusterSummary root;
+  SummarizeSurvivingClusters<connectivity>(walk, rng, 0, 0, 0, root);
+
+  // DEAD boundary: windows along the sides of the unit square and at its corners
+  const unsigned h = walk.h[0];
+  for(unsigned X = 0; X+1 < h; X++){
+    const int below[4] = { 0, 0, root.bottom[X+1], root.bottom[X] };
+    AddWindowToClusters(below, walk.functionals_of_window[convert(false, false, true, true)], root.functionals);
+    const int above[4] = { root.top[X+1], root.top[X], 0, 0 };
+    AddWindowToClusters(above, walk.functionals_of_window[convert(true, true, false, false)], root.functionals);
+  }
+  for(unsigned Y = 0; Y+1 < h; Y++){
+    const int left[4] = { root.left[Y], 0, root.left[Y+1], 0 };
+    AddWindowToClusters(left, walk.functionals_of_window[convert(true, false, true, false)], root.functionals);
+    const int right[4] = { 0, root.right[Y], 0, root.right[Y+1] };
+    AddWindowToClusters(right, walk.functionals_of_window[convert(false, true, false, true)], root.functionals);
+  }
+  const int corner_left_low[4]  = { 0, 0, root.bottom[0], 0 };
+  const int corner_right_low[4] = { 0, 0, 0, root.bottom[h-1] };
+  const int corner_left_up[4]   = { root.top[0], 0, 0, 0 };
+  const int corner_right_up[4]  = { 0, root.top[h-1], 0, 0 };
+  AddWindowToClusters(corner_left_low, walk.functionals_of_window[convert(false, false, true, false)], root.functionals);
+  AddWindowToClusters(corner_right_low, walk.functionals_of_window[convert(false, false, false, true)], root.functionals);
+  AddWindowToClusters(corner_left_up, walk.functionals_of_window[convert(true, false, false, false)], root.functionals);
+  AddWindowToClusters(corner_right_up, walk.functionals_of_window[convert(false, true, false, false)], root.functionals);
+
+  // a cluster that reaches all four sides percolates (there can only be one)
+  const unsigned N_labels = root.functionals.size();
+  std::vector<unsigned> touches(N_labels, 0);
+  for(unsigned i = 0; i < h; i++){
+    touches[root.bottom[i]] |= 1;
+    touches[root.top[i]] |= 2;
+    touches[root.left[i]] |= 4;
+    touches[root.right[i]] |= 8;
+  }
+  for(unsigned l = 1; l < N_labels; l++){
+    MinkowskiValuesPix cluster = root.functionals[l];
+    cluster.euler += walk.euler_of_sample;
+    CloseCluster(walk.clusters, cluster, touches[l] == 15);
+  }
+
+  clusters = walk.clusters;
+  return clusters.percolates;
+}
+
+
+// -------------------------
+// Instantiations for both connectivities
+// -------------------------
+
+template int LabelSurvivingClusters<NearestNeighbors> (const BinField<bool> &bw, BinField<int> &labels, const unsigned &N_threads);
+template int LabelSurvivingClusters<NextToNearestNeighbors> (const BinField<bool> &bw, BinField<int> &labels, const unsigned &N_threads);
+
+template class PercolatingClusterRows<NearestNeighbors>;
+template class PercolatingClusterRows<NextToNearestNeighbors>;
+
+template bool FractalPercolationPercolatingCluster<NearestNeighbors> (const unsigned &subdivision, const unsigned &n_approximations,
+                                                                      const double &p_turning_black, const CounterRNG &rng,
+                                                                      SurvivingClusterFunctionals &clusters);
+template bool FractalPercolationPercolatingCluster<NextToNearestNeighbors> (const unsigned &subdivision, const unsigned &n_approximations,
+                                                                            const double &p_turning_black, const CounterRNG &rng,
+                                                                            SurvivingClusterFunctionals &clusters);
@@ -0,0 +1,221 @@
+/*
+ * cluster.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#ifndef CLUSTER_H_
+#define CLUSTER_H_
+
+#include "fractal.h"
+
+// -------------------------
+// Clusters of surviving cells:
+// black = true = death
+// white = false = no death = survival
+// -------------------------
+
+
+// -------------------------
+// Connectivity of the surviving pixels, fixed at compile time:
+//
+//   struct connectivity {
+//     static constexpr const char *name;   // suffix of the executables and output files
+//     static constexpr int reach;          // a pixel is connected to the pixels yi-reach...yi+reach
+//                                          // of the neighboring columns (and xi-reach...xi+reach of rows)
+//     static constexpr int euler_of_sample;  // Euler characteristic (times 8) of a sample without any cluster
+//     // contribution (times 8) of a 2x2 window to the Euler characteristic of a cluster, where inside and
+//     // cluster are the window configurations (see convert) of the pixels inside of the sample and of the cluster
+//     static int euler_of_window(const unsigned &inside, const unsigned &cluster);
+//   };
+//
+// The Euler characteristic follows the percolating-cluster drivers.
+// -------------------------
+
+// Nearest neighbors (4-neighborhood): the dead pixels are connected to their next-to-nearest neighbors,
+// and a cluster has -euler_wbc_pix/8 of the sample where only the cluster survives
+struct NearestNeighbors {
+  static constexpr const char *name = "NN";
+  static constexpr int reach = 0;
+  static constexpr int euler_of_sample = -8;
+  // minus the dead pixels, which are all pixels inside of the sample except for the cluster
+  static int euler_of_window(const unsigned &inside, const unsigned &cluster)
+  {
+    return - rg5_euler_pix[inside & ~cluster] + rg5_euler_pix[inside];
+  }
+};
+
+// Next-to-nearest neighbors (8-neighborhood): a cluster has euler_wbc_pix/8 of the cluster
+// (with dead surroundings)
+struct NextToNearestNeighbors {
+  static constexpr const char *name = "NNN";
+  static constexpr int reach = 1;
+  static constexpr int euler_of_sample = 0;
+  static int euler_of_window(const unsigned &inside, const unsigned &cluster)
+  {
+    return rg5_euler_pix[cluster];
+  }
+};
+
+
+// Union-find (Hoshen-Kopelman) labeling of the surviving clusters of bw
+//
+// Pixels are connected according to connectivity; outside of bw everything is dead.
+// The pixels are visited once in the order of BinField<int> (xi outer, yi inner);
+// provisional labels are merged in a forest with path compression (the smaller
+// label becomes the root) and resolved in a second pass.
+// With N_threads > 1 (0 = all cores) the columns are split into strips, which are labeled
+// independently, one per thread; the clusters along the seams between neighboring strips are
+// then merged concurrently in a lock-free union-find forest. The labels do not depend on N_threads.
+// labels: 0 for dead pixels, else the label 1...N_clusters of the cluster of the pixel
+// (in the order of their first pixels)
+// returns N_clusters
+template < typename connectivity >
+int LabelSurvivingClusters(const BinField<bool> &bw, BinField<int> &labels, const unsigned &N_threads = 1);
+
+
+// Minkowski functionals (times 8, see MinkowskiValuesPix) of the surviving clusters of a sample:
+// of the percolating cluster (zero if there is none), of the largest cluster (by area, ties by
+// perimeter and Euler characteristic), and summed over all clusters
+// The area and perimeter of a cluster are those of its pixels (area_wbc_pix and perimeter_wbc_pix
+// of the sample where only the cluster is true); its Euler characteristic depends on the
+// connectivity. All of them are additive over the clusters.
+struct SurvivingClusterFunctionals {
+  bool percolates;
+  MinkowskiValuesPix percolating, largest, all;
+};
+
+
+// Number of pixels of a cluster and the sums of their positions xi and yi and of xi^2 + yi^2
+struct ClusterMoments {
+  long size, sum_x, sum_y, sum_squares;
+};
+
+// Distribution of the sizes (numbers of pixels) of the clusters that do not percolate,
+// accumulated over the clusters of a sample
+//
+// histogram(bi): number of clusters of sizes 2^bi...2^(bi+1)-1 (log-binned)
+// moments: sum over the clusters of s, s^2, and s^2 R^2 with the size s and the radius of gyration R
+// of a cluster, so that the mean cluster size is sum s^2 / sum s and the squared correlation length
+// 2 sum s^2 R^2 / sum s^2
+class ClusterSizeDistribution {
+
+ public:
+  // clusters of sizes up to max_size
+  ClusterSizeDistribution(const unsigned long &max_size);
+
+  void clear();
+  void add(const ClusterMoments &cluster);
+
+  unsigned call_N_bins() const { return histogram_.size(); }
+  long histogram(const unsigned &bi) const { return histogram_[bi]; }
+  long N_clusters() const { return N_clusters_; }
+  double sum_size() const { return sum_size_; }
+  double sum_size_squared() const { return sum_size_squared_; }
+  double sum_size_squared_radius_squared() const { return sum_size_squared_radius_squared_; }
+
+ private:
+  std::vector<long> histogram_;
+  long N_clusters_;
+  double sum_size_, sum_size_squared_, sum_size_squared_radius_squared_;
+};
+
+
+// Run of surviving pixels start...end (bounds included) in a row
+struct SurvivingRun {
+  unsigned start, end;
+};
+
+// Run-length encoding of the surviving pixels of a bit-packed row (see BinField<bool>::row)
+// of Nx pixels, from left to right
+void SurvivingRuns(const uint64_t *row, const unsigned &Nx, std::vector<SurvivingRun> &runs);
+
+
+// Streaming union-find labeling of the surviving clusters of an Nx x Ny sample, which is
+// fed row by row from the bottom row (yi = 0) to the top row as bit-packed rows (see BinField<bool>::row)
+//
+// The rows are run-length encoded and the runs are labeled: a run is connected to the runs of the
+// previous row that overlap with it, widened by connectivity::reach on both sides.
+// Only the windows where a run starts or ends are looked up; the windows in between contribute
+// equally and are added at once, so that the work per row is proportional to the number of runs
+// (apart from the encoding).
+// Only the labels of the runs of the previous and the current row are kept. Each root of the forest
+// carries flags whether its cluster touches the left, right, bottom, or top side, and the
+// functionals (times 8) of its cluster, which are summed up window by window from the
+// configurations of the 2x2 windows between the two rows. After each row the forest is
+// compacted to the clusters in the current row, so that the memory is O(Nx); a cluster that
+// does not reach into the current row is complete.
+template < typename connectivity >
+class PercolatingClusterRows {
+
+ public:
+  PercolatingClusterRows(const unsigned &Nx, const unsigned &Ny);
+
+  void add_row(const uint64_t *row);
+
+  // after the top row: whether a surviving cluster touches all four sides (there can only be one),
+  // and its Euler characteristic (0 if there is none)
+  bool percolates() const { return clusters_.percolates; }
+  int percolating_euler() const { return clusters_.percolating.euler/8; }
+  // after the top row: the functionals of the percolating, the largest, and all clusters
+  const SurvivingClusterFunctionals& functionals() const { return clusters_; }
+
+  // add the clusters that do not percolate to sizes (0 = none), which has to be set before the first row
+  void record_sizes(ClusterSizeDistribution *sizes) { sizes_ = sizes; }
+
+ private:
+  enum { LEFT = 1, RIGHT = 2, BOTTOM = 4, TOP = 8 };
+
+  int find_root(int l);
+  int merge(const int &l, const int &m);
+  int new_label(const unsigned &touches);
+  // windows between the previous and the current row (either may lie outside of the sample)
+  void add_windows(const bool &low_inside, const bool &up_inside);
+  // label of the pixel xi in runs with labels, where run ri is the first run that may contain xi
+  // (moved on to the run that contains xi or lies to its right)
+  int label_of_pixel(const std::vector<SurvivingRun> &runs, const std::vector<int> &labels, unsigned &ri, const unsigned &xi) const;
+  void compact();
+  void close_cluster(const int &root);
+
+  unsigned Nx_, Ny_;
+  unsigned yi_;
+  // functionals_of_window_[inside][cluster]: contributions (times 8) of a window to the functionals
+  // of a cluster, where inside and cluster are the window configurations (see convert) of the pixels
+  // inside of the sample and of the pixels of the cluster (shared by all labelings with connectivity)
+  const MinkowskiValuesPix (&functionals_of_window_)[16][16];
+  // runs of the previous and the current row and their labels
+  std::vector<SurvivingRun> previous_runs_, current_runs_;
+  std::vector<int> previous_labels_, current_labels_;
+  // starts and ends (plus one) of the runs of both rows, i.e., the windows that can contribute
+  std::vector<unsigned> previous_ends_, current_ends_, windows_;
+  // forest of the labels (label 0 = "dead/black/true")
+  std::vector<int> parent_;
+  std::vector<unsigned> touches_;
+  std::vector<MinkowskiValuesPix> functionals_;
+  std::vector<ClusterMoments> moments_;
+  std::vector<int> new_index_;
+  SurvivingClusterFunctionals clusters_;
+  ClusterSizeDistribution *sizes_;
+};
+
+
+// Percolation of the final approximation of the realization that RandomFractalPercolationBinField
+// draws with the same rng, decided bottom-up along the subdivision tree without any pixel field
+//
+// Each surviving cell is summarized by the labels of the surviving clusters of its pixels along
+// its four sides and, for each of these clusters, its functionals (times 8) from the
+// windows inside of the cell. The summaries of the subdivision x subdivision children of a cell
+// are glued along the windows across the seams between them; clusters that do not reach the sides
+// of the cell are complete and recorded in clusters. The root percolates if a cluster reaches all four sides.
+// The work is proportional to the surviving cells (times their perimeters), the memory is
+// O(subdivision^n_approximations).
+// Connectivity and functionals as for PercolatingClusterRows;
+// returns whether the surviving cells percolate, and the functionals of the clusters
+template < typename connectivity >
+bool FractalPercolationPercolatingCluster (const unsigned &subdivision, const unsigned &n_approximations,
+                                          const double &p_turning_black, const CounterRNG &rng,
+                                          SurvivingClusterFunctionals &clusters);
+
+
+#endif /* CLUSTER_H_ */
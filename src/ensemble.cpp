@@ -0,0 +1,60 @@
+/*
+ * ensemble.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#include "ensemble.h"
+
+EnsembleSums::EnsembleSums(const unsigned &N_observables) :
+N_runs_ ( 0 ), sum_ ( std::vector< double > (N_observables, 0) ), sum_of_squares_ ( std::vector< double > (N_observables, 0) )
+{}
+
+void EnsembleSums::add(const std::vector<double> &observables)
+{
+  if(observables.size() != sum_.size()){
+    std::cerr << "ERROR: EnsembleSums recieved " << observables.size() << " observables "
+              << "instead of " << sum_.size() << ";" << std::endl;
+    exit(-1);
+  }
+  for(unsigned oi = 0; oi < sum_.size(); oi++){
+    sum_[oi] += observables[oi];
+    sum_of_squares_[oi] += observables[oi]*observables[oi];
+  }
+  N_runs_++;
+}
+
+void EnsembleSums::add(const EnsembleSums &sums)
+{
+  if(sums.sum_.size() != sum_.size()){
+    std::cerr << "ERROR: EnsembleSums recieved sums of " << sums.sum_.size() << " observables "
+              << "instead of " << sum_.size() << ";" << std::endl;
+    exit(-1);
+  }
+  for(unsigned oi = 0; oi < sum_.size(); oi++){
+    sum_[oi] += sums.sum_[oi];
+    sum_of_squares_[oi] += sums.sum_of_squares_[oi];
+  }
+  N_runs_ += sums.N_runs_;
+}
+
+unsigned EnsembleSums::call_N_observables() const
+{
+  return sum_.size();
+}
+
+unsigned EnsembleSums::call_N_runs() const
+{
+  return N_runs_;
+}
+
+double EnsembleSums::mean(const unsigned &oi) const
+{
+  return sum_.at(oi)/N_runs_;
+}
+
+double EnsembleSums::std_error(const unsigned &oi) const
+{
+  return sqrt((sum_of_squares_.at(oi) - pow(sum_.at(oi),2)/N_runs_)/N_runs_/(N_runs_-1));
+}
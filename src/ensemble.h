@@ -0,0 +1,121 @@
+/*
+ * ensemble.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
+
+#include "aux.h"
+
+// -------------------------
+// Sums of the observables of an ensemble of simulation runs
+// -------------------------
+class EnsembleSums {
+
+ public:
+  EnsembleSums(const unsigned &N_observables);
+
+  void add(const std::vector<double> &observables);
+  // add the sums of another (disjoint) set of runs
+  void add(const EnsembleSums &sums);
+
+  unsigned call_N_observables() const;
+  unsigned call_N_runs() const;
+
+  // mean value of the oi-th observable
+  double mean(const unsigned &oi) const;
+  // standard error of the mean of the oi-th observable
+  double std_error(const unsigned &oi) const;
+
+ private:
+  unsigned N_runs_;
+  std::vector< double > sum_;
+  std::vector< double > sum_of_squares_;
+};
+
+
+// -------------------------
+// Thread-pool ensemble runner
+//
+// Each of the N_threads workers constructs its own simulation object, which owns
+// all workspaces of a run:
+//
+//   class simulation {
+//    public:
+//     simulation();
+//     void run(const unsigned &run, std::vector<double> &observables);
+//   };
+//
+// The runs first_run...first_run+N_runs-1 are split into at most max_ensemble_chunks
+// chunks of consecutive runs, whose size depends only on N_runs. The chunks are handed
+// out one after the other to idle workers, which sum up the observables of the runs of
+// a chunk in their order. A run has to draw its random numbers from a generator keyed
+// by the run index (see CounterRNG), so that it can be reproduced on its own.
+// Finally, the sums of the chunks are added in the order of the chunks, so that the
+// sums do not depend on the number of threads, while the memory is independent of N_runs.
+// -------------------------
+static const size_t max_ensemble_chunks = 1024;
+
+template < typename simulation >
+void EnsembleWorker(const unsigned &first_run, const size_t &N_runs, const size_t &runs_per_chunk,
+                    std::atomic<size_t> &next_chunk, std::vector<EnsembleSums> &chunk_sums)
+{
+  simulation sim;
+  std::vector<double> observables(chunk_sums[0].call_N_observables(), 0);
+
+  for(size_t ci = next_chunk++; ci < chunk_sums.size(); ci = next_chunk++){
+    size_t end_run = std::min(N_runs, (ci+1)*runs_per_chunk);
+    for(size_t ri = ci*runs_per_chunk; ri < end_run; ri++){
+      sim.run(first_run + ri, observables);
+      chunk_sums[ci].add(observables);
+    }
+  }
+}
+
+template < typename simulation >
+EnsembleSums RunEnsemble(const unsigned &N_observables, const unsigned &first_run,
+                         const unsigned &N_runs, const unsigned &N_threads)
+{
+  EnsembleSums sums(N_observables);
+  if(N_runs == 0)
+    return sums;
+
+  size_t runs_per_chunk = (size_t(N_runs) + max_ensemble_chunks - 1)/max_ensemble_chunks;
+  size_t N_chunks = (size_t(N_runs) + runs_per_chunk - 1)/runs_per_chunk;
+
+  unsigned N_workers = N_threads;
+  if(N_workers == 0)
+    N_workers = std::max(1u, std::thread::hardware_concurrency());
+  N_workers = std::min(size_t(N_workers), N_chunks);
+
+  std::atomic<size_t> next_chunk(0);
+  std::vector<EnsembleSums> chunk_sums(N_chunks, EnsembleSums(N_observables));
+
+  if(N_workers == 1)
+    EnsembleWorker<simulation>(first_run, N_runs, runs_per_chunk, next_chunk, chunk_sums);
+  else{
+    std::vector<std::thread> pool;
+    for(unsigned ti = 0; ti < N_workers; ti++)
+      pool.push_back(std::thread(EnsembleWorker<simulation>, first_run, size_t(N_runs), runs_per_chunk,
+                                 std::ref(next_chunk), std::ref(chunk_sums)));
+    for(unsigned ti = 0; ti < N_workers; ti++)
+      pool[ti].join();
+  }
+
+  for(size_t ci = 0; ci < N_chunks; ci++)
+    sums.add(chunk_sums[ci]);
+
+  return sums;
+}
+
+
+#endif /* ENSEMBLE_H_ */
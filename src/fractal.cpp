@@ -0,0 +1,355 @@
+/*
+ * fractal.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#include "fractal.h"
+
+// Draw the children of the surviving cell (xi,yi) in the k-th approximation
+// and descend into those children that survive as well
+static void RefineSurvivingCell (BinField<bool> &final_approximation, const unsigned &subdivision,
+                                 const unsigned &n_approximations, const double &p_turning_black,
+                                 const std::vector<unsigned> &h, const unsigned &k,
+                                 const unsigned &xi, const unsigned &yi, const CounterRNG &rng)
+{
+  // children live in the (k+1)-th approximation
+  const unsigned hc = h[k+1];
+
+  for(unsigned cx = xi*subdivision; cx < (xi+1)*subdivision; cx++)
+    for(unsigned cy = yi*subdivision; cy < (yi+1)*subdivision; cy++){
+      if( rng.uniform(k+1, cx, cy) < p_turning_black ){ // if cell dies
+        // all offsprings die in final_approximation
+        final_approximation.assign_block(cx*hc, (cx+1)*hc-1, cy*hc, (cy+1)*hc-1, true);
+      }
+      else if(k+1 < n_approximations)
+        RefineSurvivingCell(final_approximation, subdivision, n_approximations, p_turning_black, h, k+1, cx, cy, rng);
+    }
+}
+
+
+// Check the dimensions and walk the subdivision tree from the unit square
+static void RefineUnitSquare (BinField<bool> &final_approximation, const unsigned &subdivision,
+                              const unsigned &n_approximations, const double &p_turning_black,
+                              const CounterRNG &rng)
+{
+  std::vector<unsigned> h = BlockSizesPerLevel(subdivision, n_approximations);
+
+  if(final_approximation.call_Nx() != h[0] || final_approximation.call_Ny() != h[0])
+    {
+      std::cerr << "ERROR: RandomFractalPercolationBinField recieved a " << final_approximation.call_Nx()
+                << "x" << final_approximation.call_Ny() << " BinField;" << std::endl
+                << "       Needed " << h[0] << "x" << h[0] << " BinField." << std::endl;
+      exit(-1);
+    }
+
+  // the 0-th approximation (the unit square) always survives
+  if(n_approximations > 0)
+    RefineSurvivingCell(final_approximation, subdivision, n_approximations, p_turning_black, h, 0, 0, 0, rng);
+}
+
+
+std::vector<unsigned> BlockSizesPerLevel (const unsigned &subdivision, const unsigned &n_approximations)
+{
+  std::vector<unsigned> h(n_approximations+1, 1);
+  for(unsigned k = n_approximations; k > 0; k--)
+    h[k-1] = h[k]*subdivision;
+
+  return h;
+}
+
+
+void RandomFractalPercolationBinField (BinField<bool> &final_approximation, const unsigned &subdivision,
+                                       const unsigned &n_approximations, const double &p_turning_black,
+                                       const CounterRNG &rng)
+{
+  RefineUnitSquare(final_approximation, subdivision, n_approximations, p_turning_black, rng);
+}
+
+
+void RefineFractalPercolationBinField (const BinField<bool> &coarse_approximation, BinField<bool> &fine_approximation,
+                                       const unsigned &subdivision, const unsigned &k,
+                                       const double &p_turning_black, const CounterRNG &rng)
+{
+  const unsigned Nx = coarse_approximation.call_Nx();
+  const unsigned Ny = coarse_approximation.call_Ny();
+
+  if(fine_approximation.call_Nx() != Nx*subdivision || fine_approximation.call_Ny() != Ny*subdivision)
+    {
+      std::cerr << "ERROR: RefineFractalPercolationBinField recieved a " << fine_approximation.call_Nx()
+                << "x" << fine_approximation.call_Ny() << " BinField;" << std::endl
+                << "       Needed " << Nx*subdivision << "x" << Ny*subdivision << " BinField." << std::endl;
+      exit(-1);
+    }
+
+  for(unsigned xi = 0; xi < Nx; xi++)
+    for(unsigned yi = 0; yi < Ny; yi++){
+      if(coarse_approximation.call(xi,yi)) // dead cells have dead children
+        fine_approximation.assign_block(xi*subdivision, (xi+1)*subdivision-1, yi*subdivision, (yi+1)*subdivision-1, true);
+      else
+        for(unsigned cx = xi*subdivision; cx < (xi+1)*subdivision; cx++)
+          for(unsigned cy = yi*subdivision; cy < (yi+1)*subdivision; cy++)
+            fine_approximation.assign(cx,cy, rng.uniform(k, cx, cy) < p_turning_black);
+    }
+}
+
+
+FractalPercolationRows::FractalPercolationRows(const unsigned &subdivision, const unsigned &n_approximations,
+                                               const double &p_turning_black, const CounterRNG &rng, const bool &invert) :
+FractalPercolationRows(subdivision, n_approximations, std::vector<double>(1, p_turning_black), rng, invert)
+{}
+
+FractalPercolationRows::FractalPercolationRows(const unsigned &subdivision, const unsigned &n_approximations,
+                                               const std::vector<double> &p_turning_black, const CounterRNG &rng, const bool &invert) :
+subdivision_ ( subdivision ), n_approximations_ ( n_approximations ), p_turning_black_ ( p_turning_black ),
+rng_ ( rng ), invert_ ( invert ), h_ ( BlockSizesPerLevel(subdivision, n_approximations) )
+{
+  if(p_turning_black_.empty() || !std::is_sorted(p_turning_black_.begin(), p_turning_black_.end())){
+    std::cerr << "ERROR: FractalPercolationRows recieved " << p_turning_black_.size()
+              << " probabilities, which have to be in ascending order;" << std::endl;
+    exit(-1);
+  }
+
+  Nx_ = h_[0];
+  Nw_ = (Nx_+63)/64;
+  words_.resize(p_turning_black_.size()*Nw_, 0);
+
+  // the 0-th approximation (the unit square) always survives;
+  // no rows of the finer approximations have been drawn yet
+  surviving_.resize(n_approximations_ + 1);
+  yi_.resize(n_approximations_ + 1, Nx_);
+  Cell unit_square = { 0, 1. };
+  surviving_[0].push_back(unit_square);
+  yi_[0] = 0;
+}
+
+const uint64_t* FractalPercolationRows::row(const unsigned &yi)
+{
+  const unsigned M = subdivision_;
+  const unsigned n = n_approximations_;
+  const unsigned N_p = p_turning_black_.size();
+
+  // rows of ancestors, starting from the coarsest one that changes
+  for(unsigned k = 1; k < n; k++){
+    if(yi_[k] == yi/h_[k])
+      continue;
+    yi_[k] = yi/h_[k];
+    surviving_[k].clear();
+    for(unsigned pi = 0; pi < surviving_[k-1].size(); pi++){
+      const Cell &parent = surviving_[k-1][pi];
+      for(unsigned xi = parent.xi*M; xi < (parent.xi+1)*M; xi++){
+        Cell child = { xi, std::min(parent.u, rng_.uniform(k, xi, yi_[k])) };
+        if( child.u >= p_turning_black_[0] )
+          surviving_[k].push_back(child);
+      }
+    }
+  }
+
+  // pixels of the final approximation: a pixel survives at p_turning_black[0...j-1], where
+  // p_turning_black[j] is the first one above its uniform; mark it in row j-1 only and
+  // fill in the rows below afterwards (the surviving sets are nested)
+  std::fill(words_.begin(), words_.end(), 0);
+  if(n == 0)
+    words_[(N_p-1)*Nw_] = 1;
+  else{
+    const std::vector<Cell> &parents = surviving_[n-1];
+    for(unsigned pi = 0; pi < parents.size(); pi++)
+      for(unsigned xi = parents[pi].xi*M; xi < (parents[pi].xi+1)*M; xi++){
+        double u = std::min(parents[pi].u, rng_.uniform(n, xi, yi));
+        unsigned j = std::upper_bound(p_turning_black_.begin(), p_turning_black_.end(), u) - p_turning_black_.begin();
+        if(j > 0)
+          words_[(j-1)*Nw_ + (xi >> 6)] |= uint64_t(1) << (xi & 63);
+      }
+  }
+  for(unsigned pi = N_p-1; pi > 0; pi--)
+    for(unsigned wi = 0; wi < Nw_; wi++)
+      words_[(pi-1)*Nw_ + wi] |= words_[pi*Nw_ + wi];
+
+  // black = true = death
+  if(!invert_){
+    for(unsigned wi = 0; wi < words_.size(); wi++)
+      words_[wi] = ~words_[wi];
+    if(Nx_ % 64 != 0)
+      for(unsigned pi = 0; pi < N_p; pi++)
+        words_[pi*Nw_ + Nw_-1] &= (uint64_t(1) << (Nx_ % 64)) - 1;
+  }
+
+  return &words_[0];
+}
+
+
+// -------------------------
+// Minkowski functionals along the subdivision tree
+// -------------------------
+
+// Boundary summary of a cell: its pixels along the four sides (bottom and top
+// from left to right, left and right from bottom to top) and the functionals
+// (times 8) of all windows inside of the cell
+struct CellSummary {
+  std::vector<char> bottom, top, left, right;
+  long area, perimeter, euler;
+};
+
+// Parameters and workspaces of the tree walk: the summaries of the children
+// of the current cell in the k-th approximation are children[k][cx*subdivision+cy]
+struct SummaryWalk {
+  unsigned subdivision, n_approximations;
+  double p_turning_black;
+  bool invert;
+  std::vector<unsigned> h;
+  std::vector< std::vector<CellSummary> > children;
+  // pixels of a cell in the (n_approximations-1)-th approximation
+  std::vector<char> pixels;
+};
+
+static inline void AddWindow (CellSummary &cell, const unsigned &conf)
+{
+  cell.area += rg5_area_pix[conf];
+  cell.perimeter += rg5_perimeter_pix[conf];
+  cell.euler += rg5_euler_pix[conf];
+}
+
+// Summary of a cell of h x h pixels that are all value
+static void UniformCell (CellSummary &cell, const unsigned &h, const bool &value)
+{
+  cell.bottom.assign(h, value);
+  cell.top.assign(h, value);
+  cell.left.assign(h, value);
+  cell.right.assign(h, value);
+
+  long N_windows = long(h-1)*(h-1);
+  unsigned conf = value ? 15 : 0;
+  cell.area = N_windows*rg5_area_pix[conf];
+  cell.perimeter = N_windows*rg5_perimeter_pix[conf];
+  cell.euler = N_windows*rg5_euler_pix[conf];
+}
+
+// Summary of the surviving cell (xi,yi) in the k-th approximation, merged from the summaries
+// of its children and the windows along the seams between the children
+static void SummarizeSurvivingCell (SummaryWalk &walk, const CounterRNG &rng, const unsigned &k,
+                                    const unsigned &xi, const unsigned &yi, CellSummary &cell)
+{
+  const bool alive = walk.invert; // pixel values as seen by the functionals
+  if(k == walk.n_approximations){
+    UniformCell(cell, 1, alive);
+    return;
+  }
+
+  const unsigned M = walk.subdivision;
+  const unsigned hc = walk.h[k+1];
+  const unsigned h = walk.h[k];
+  std::vector<CellSummary> &child = walk.children[k];
+
+  // children are single pixels: summarize the M x M pixels directly
+  if(hc == 1){
+    cell.bottom.resize(M);
+    cell.top.resize(M);
+    cell.left.resize(M);
+    cell.right.resize(M);
+    std::vector<char> &pixels = walk.pixels;
+    for(unsigned cx = 0; cx < M; cx++)
+      for(unsigned cy = 0; cy < M; cy++)
+        pixels[cx*M+cy] = ( rng.uniform(k+1, xi*M+cx, yi*M+cy) < walk.p_turning_black ) ? !alive : alive;
+
+    cell.area = cell.perimeter = cell.euler = 0;
+    for(unsigned X = 0; X+1 < M; X++)
+      for(unsigned Y = 0; Y+1 < M; Y++)
+        AddWindow(cell, convert(pixels[(X+1)*M+Y], pixels[X*M+Y], pixels[(X+1)*M+Y+1], pixels[X*M+Y+1]));
+    for(unsigned ci = 0; ci < M; ci++){
+      cell.bottom[ci] = pixels[ci*M];
+      cell.top[ci] = pixels[ci*M + M-1];
+      cell.left[ci] = pixels[ci];
+      cell.right[ci] = pixels[(M-1)*M + ci];
+    }
+    return;
+  }
+
+  cell.area = cell.perimeter = cell.euler = 0;
+  for(unsigned cx = 0; cx < M; cx++)
+    for(unsigned cy = 0; cy < M; cy++){
+      CellSummary &c = child[cx*M+cy];
+      if( rng.uniform(k+1, xi*M+cx, yi*M+cy) < walk.p_turning_black ) // if cell dies
+        UniformCell(c, hc, !alive);
+      else
+        SummarizeSurvivingCell(walk, rng, k+1, xi*M+cx, yi*M+cy, c);
+
+      cell.area += c.area;
+      cell.perimeter += c.perimeter;
+      cell.euler += c.euler;
+    }
+
+  // windows across the vertical seams, including the junctions of four children
+  for(unsigned cx = 0; cx+1 < M; cx++)
+    for(unsigned cy = 0; cy < M; cy++){
+      const CellSummary &left = child[cx*M + cy], &right = child[(cx+1)*M + cy];
+      for(unsigned y = 0; y+1 < hc; y++)
+        AddWindow(cell, convert(right.left[y], left.right[y], right.left[y+1], left.right[y+1]));
+      if(cy+1 < M){
+        const CellSummary &left_up = child[cx*M + cy+1], &right_up = child[(cx+1)*M + cy+1];
+        AddWindow(cell, convert(right.left[hc-1], left.right[hc-1], right_up.left[0], left_up.right[0]));
+      }
+    }
+
+  // windows across the horizontal seams, without the junctions
+  for(unsigned cy = 0; cy+1 < M; cy++)
+    for(unsigned cx = 0; cx < M; cx++){
+      const CellSummary &low = child[cx*M + cy], &up = child[cx*M + cy+1];
+      for(unsigned x = 0; x+1 < hc; x++)
+        AddWindow(cell, convert(low.top[x+1], low.top[x], up.bottom[x+1], up.bottom[x]));
+    }
+
+  // sides of the cell
+  cell.bottom.resize(h);
+  cell.top.resize(h);
+  cell.left.resize(h);
+  cell.right.resize(h);
+  for(unsigned ci = 0; ci < M; ci++){
+    std::copy(child[ci*M].bottom.begin(), child[ci*M].bottom.end(), cell.bottom.begin() + ci*hc);
+    std::copy(child[ci*M + M-1].top.begin(), child[ci*M + M-1].top.end(), cell.top.begin() + ci*hc);
+    std::copy(child[ci].left.begin(), child[ci].left.end(), cell.left.begin() + ci*hc);
+    std::copy(child[(M-1)*M + ci].right.begin(), child[(M-1)*M + ci].right.end(), cell.right.begin() + ci*hc);
+  }
+}
+
+
+MinkowskiValuesPix FractalPercolationMinkowskiPix (const unsigned &subdivision, const unsigned &n_approximations,
+                                                   const double &p_turning_black, const CounterRNG &rng,
+                                                   const bool &invert)
+{
+  SummaryWalk walk;
+  walk.subdivision = subdivision;
+  walk.n_approximations = n_approximations;
+  walk.p_turning_black = p_turning_black;
+  walk.invert = invert;
+  walk.h = BlockSizesPerLevel(subdivision, n_approximations);
+  walk.children.resize(n_approximations, std::vector<CellSummary>(subdivision*subdivision));
+  walk.pixels.resize(subdivision*subdivision);
+
+  // the 0-th approximation (the unit square) always survives
+  CellSummary root;
+  SummarizeSurvivingCell(walk, rng, 0, 0, 0, root);
+
+  // white boundary condition: windows along the sides of the unit square
+  const unsigned h = walk.h[0];
+  for(unsigned X = 0; X+1 < h; X++){
+    AddWindow(root, convert(false, false, root.bottom[X+1], root.bottom[X])); // below
+    AddWindow(root, convert(root.top[X+1], root.top[X], false, false));       // above
+  }
+  for(unsigned Y = 0; Y+1 < h; Y++){
+    AddWindow(root, convert(root.left[Y], false, root.left[Y+1], false));     // left
+    AddWindow(root, convert(false, root.right[Y], false, root.right[Y+1]));   // right
+  }
+  // corners
+  AddWindow(root, convert(false, false, root.bottom[0], false));
+  AddWindow(root, convert(false, false, false, root.bottom[h-1]));
+  AddWindow(root, convert(root.top[0], false, false, false));
+  AddWindow(root, convert(false, root.top[h-1], false, false));
+
+  MinkowskiValuesPix values;
+  values.area = root.area;
+  values.perimeter = root.perimeter;
+  values.euler = root.euler;
+
+  return values;
+}
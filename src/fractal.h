@@ -0,0 +1,119 @@
+/*
+ * fractal.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#ifndef FRACTAL_H_
+#define FRACTAL_H_
+
+#include <algorithm>
+
+#include "minkowski.h"
+
+// -------------------------
+// Fractal percolation:
+// black = true = death
+// white = false = no death = survival
+// -------------------------
+
+
+// Number of small pixels in the final approximation that correspond
+// to one pixel (per side) in the k-th approximation, for k = 0...n_approximations
+std::vector<unsigned> BlockSizesPerLevel (const unsigned &subdivision, const unsigned &n_approximations);
+
+
+// Random final approximation of fractal percolation on a BinField of
+// subdivision^n_approximations x subdivision^n_approximations pixels
+//
+// The subdivision tree is walked depth first; only the children of surviving
+// cells are drawn, and a dying cell kills its whole block of offsprings at once.
+// final_approximation has to be alive (false) everywhere on input.
+// The fate of the cell (xi,yi) in the k-th approximation is decided by rng.uniform(k,xi,yi),
+// so that a realization does not depend on the order of the walk.
+void RandomFractalPercolationBinField (BinField<bool> &final_approximation, const unsigned &subdivision,
+                                       const unsigned &n_approximations, const double &p_turning_black,
+                                       const CounterRNG &rng);
+
+
+// Refine the (k-1)-th approximation to the k-th approximation of the same realization
+//
+// Each surviving cell of coarse_approximation is subdivided into subdivision x subdivision
+// children, whose fates are drawn by rng.uniform(k,xi,yi) as in RandomFractalPercolationBinField.
+// Starting from a single surviving pixel, n refinements yield the same final approximation as
+// RandomFractalPercolationBinField with n_approximations = n and the same rng.
+void RefineFractalPercolationBinField (const BinField<bool> &coarse_approximation, BinField<bool> &fine_approximation,
+                                       const unsigned &subdivision, const unsigned &k,
+                                       const double &p_turning_black, const CounterRNG &rng);
+
+
+// Rows of the final approximation of the realization that RandomFractalPercolationBinField
+// draws with the same rng, generated one after the other without the final approximation
+//
+// A pixel dies if any of its ancestors dies. For each level k only the surviving cells
+// in the row that contains the ancestors of the current row are kept, and they are only
+// redrawn if the current row moves into the next row of cells. Rows are bit-packed as in
+// BinField<bool>, and streaming them from bottom to top costs O(subdivision^n_approximations) memory.
+// invert: rows of the surviving instead of the dying cells (as after BinField<bool>::invert())
+//
+// Sweep: a cell dies at every p_turning_black above its uniform, so that a single pass yields
+// the rows of the coupled realizations of a whole list of p_turning_black (in ascending order).
+// Each cell keeps the minimum of the uniforms of its ancestors, and only cells that survive
+// at least at the smallest p_turning_black are drawn. For a single p_turning_black the rows are
+// the same as above.
+class FractalPercolationRows {
+
+ public:
+  FractalPercolationRows(const unsigned &subdivision, const unsigned &n_approximations,
+                         const double &p_turning_black, const CounterRNG &rng, const bool &invert = false);
+  FractalPercolationRows(const unsigned &subdivision, const unsigned &n_approximations,
+                         const std::vector<double> &p_turning_black, const CounterRNG &rng, const bool &invert = false);
+
+  unsigned call_Nx() const { return Nx_; }
+  unsigned call_Nw() const { return Nw_; }
+  unsigned call_N_p() const { return p_turning_black_.size(); }
+
+  // Row yi of the final approximation for each p_turning_black[pi], starting at word pi*call_Nw()
+  // (valid until the next call)
+  const uint64_t* row(const unsigned &yi);
+
+ private:
+  struct Cell {
+    unsigned xi;
+    // minimum of the uniforms of the cell and its ancestors
+    double u;
+  };
+
+  unsigned subdivision_, n_approximations_;
+  std::vector<double> p_turning_black_;
+  CounterRNG rng_;
+  bool invert_;
+  unsigned Nx_, Nw_;
+  std::vector<unsigned> h_;
+  // surviving_[k]: the surviving cells of the k-th approximation in the current row
+  // of ancestors yi_[k], for k = 0...n_approximations-1
+  std::vector< std::vector<Cell> > surviving_;
+  std::vector<unsigned> yi_;
+  std::vector<uint64_t> words_;
+};
+
+
+// Functionals of the final approximation of the realization that RandomFractalPercolationBinField
+// draws with the same rng, without the final approximation itself
+//
+// Each surviving cell is summarized bottom-up by the pixels along its four sides and the
+// functionals of the windows inside of it; the windows along the seams between neighboring
+// children are looked up from the children's sides. The memory is O(subdivision^n_approximations)
+// instead of O(subdivision^(2*n_approximations)).
+// invert: functionals of the surviving instead of the dying cells (as after BinField<bool>::invert())
+MinkowskiValuesPix FractalPercolationMinkowskiPix (const unsigned &subdivision, const unsigned &n_approximations,
+                                                   const double &p_turning_black, const CounterRNG &rng,
+                                                   const bool &invert = false);
+// Below this expected fraction of surviving pixels (p^n_approximations), FractalPercolationMinkowskiPix,
+// whose work is proportional to the surviving cells, is faster than streaming all rows of the
+// final approximation (FractalPercolationRows and EulerWbcPixRows)
+const double max_surviving_fraction_minkowski_pix = 1./1024;
+
+
+#endif /* FRACTAL_H_ */
@@ -14,11 +14,16 @@ void initialize(int clc, char* clv[],
                std::string &config_file,
                std::string &prefix_of,
                double &p,
+               std::vector<double> &p_list,
                unsigned &subdivision,
                unsigned &n_approximations,
+               bool &all_levels,
+               bool &cluster_sizes,
                unsigned &N_runs,
+               unsigned &first_run,
                bool &imageout,
-               unsigned &seed)
+               unsigned &seed,
+               unsigned &N_threads)
 {
   try{
       progopt::options_description generic("Generic options");
@@ -32,11 +37,16 @@ void initialize(int clc, char* clv[],
       config.add_options()
           ("prefix_of,o",        progopt::value<std::string>(&prefix_of)->default_value(prefix_of),            "Set prefix for output files")
           ("survival_prob,p",    progopt::value<double>(&p)->default_value(p),                                 "Probability of survival of each cell in each iteration")
+          ("p_list,P",           progopt::value< std::vector<double> >(&p_list)->multitoken(),                 "Sweep over several survival probabilities (coupled realizations)")
           ("subdivision,M",      progopt::value<unsigned>(&subdivision)->default_value(subdivision),           "Number of subdivisions")
           ("n_approximations,n", progopt::value<unsigned>(&n_approximations)->default_value(n_approximations), "Number of approximations")
+          ("all_levels,a",       progopt::value<bool>(&all_levels)->default_value(all_levels),                 "Set whether or not to record every level of approximation")
+          ("cluster_sizes,c",    progopt::value<bool>(&cluster_sizes)->default_value(cluster_sizes),           "Set whether or not to record the distribution of the cluster sizes")
           ("Nruns,R",            progopt::value<unsigned>(&N_runs)->default_value(N_runs),                     "Number of simulation runs")
+          ("first_run,f",        progopt::value<unsigned>(&first_run)->default_value(first_run),               "Index of the first simulation run")
           ("image,i",            progopt::value<bool>(&imageout)->default_value(imageout),                     "Set whether or not to print an image")
           ("seed,s",             progopt::value<unsigned>(&seed)->default_value(seed),                         "Set seed of random number generators")
+          ("threads,t",          progopt::value<unsigned>(&N_threads)->default_value(N_threads),               "Number of threads for the simulation runs (0 = all cores)")
           ;
 
       progopt::options_description cmdlineopt("\nMandelbrot Percolation - Options");
@@ -81,11 +91,19 @@ void initialize(int clc, char* clv[],
       std::cout << "# Version: " << VERSION << std::endl
           << std::endl
           << "# Probability of survival of each cell in each iteration: p = " << p << std::endl
+          << "# Sweep over the survival probabilities:                  p_list =";
+      for(unsigned pi = 0; pi < p_list.size(); pi++)
+          std::cout << " " << p_list[pi];
+      std::cout << std::endl
           << "# Number of subdivisions:                                 subdivision = " << subdivision << std::endl
           << "# Number of approximations:                               n_approximations = " << n_approximations << std::endl
+          << "# Record every level of approximation:                    all_levels = " << all_levels << std::endl
+          << "# Record the distribution of the cluster sizes:          cluster_sizes = " << cluster_sizes << std::endl
           << "# Number of simulation runs:                              N_runs = " << N_runs << std::endl
+          << "# Index of the first simulation run:                      first_run = " << first_run << std::endl
           << "# Print an image to a pgm-file:                           imageout = " << imageout << std::endl
           << "# Seed of random number generators:                       seed = " << seed << std::endl
+          << "# Number of threads for the simulation runs:              threads = " << N_threads << std::endl
           << "# Configuration file:                                     config = " << config_file << std::endl
           << "# Prefix for output files:                                prefix_of = " << prefix_of << std::endl
           << std::endl;
@@ -9,6 +9,7 @@
 #define INIT_H_
 
 #include <string>
+#include <vector>
 //#include <algorithm>
 
 #include <boost/program_options.hpp>
@@ -24,21 +25,31 @@ const std::string VERSION = "19.01";
  * parameter: config_file       Configuration file to read parameters from
  * parameter: prefix_of         Folder for output, i.e. prefix for output files
  * parameter: p                 Fractal percolation: survival probability
+ * parameter: p_list            Fractal percolation: survival probabilities of a sweep over coupled realizations (replaces p if not empty)
  * parameter: subdivision       Fractal percolation: Parameter M of subdivisions
  * parameter: n_approximations  Fractal percolation: Level of approximation
+ * parameter: all_levels        Flag whether to record every level k = 1...n_approximations of a realization
+ * parameter: cluster_sizes     Flag whether to record the distribution of the sizes of the clusters
  * parameter: N_runs            Fractal percolation: Number of simulation runs
+ * parameter: first_run         Fractal percolation: Index of the first simulation run
  * parameter: imageout          Flag whether a pgm image shall be created
  * parameter: seed              Seed of the random number generator
+ * parameter: N_threads         Number of threads for the ensemble of runs (0 = all cores)
  */
 void initialize(int clc, char* clv[],
                std::string &config_file,
                std::string &prefix_of,
                double &p,
+               std::vector<double> &p_list,
                unsigned &subdivision,
                unsigned &n_approximations,
+               bool &all_levels,
+               bool &cluster_sizes,
                unsigned &N_runs,
+               unsigned &first_run,
                bool &imageout,
-               unsigned &seed);
+               unsigned &seed,
+               unsigned &N_threads);
 
 
 #endif /* INIT_H_ */
@@ -8,150 +8,156 @@
 #ifndef LOOKUPTABLE_H_
 #define LOOKUPTABLE_H_
 
+#include <array>
 #include <cmath>
 #include "aux.h"
 
+// sqrt(1/2), sqrt(2), and sqrt(1/8) rounded to double (as std::sqrt, which is not constexpr)
+constexpr double sqrt_1_2 = 0.70710678118654752440;
+constexpr double sqrt_2 = 1.41421356237309504880;
+constexpr double sqrt_1_8 = 0.35355339059327376220;
+
 // ------------------------------------------------------------------------------------------------------- //
 // Range 5
-const std::vector<double> rg5_area = stdvector16(0,0.125,0.125,0.5,0.125,0.5,0.75,0.875,0.125,0.75,0.5,0.875,0.5,0.875,0.875,1);
+constexpr std::array<double,16> rg5_area = {{0,0.125,0.125,0.5,0.125,0.5,0.75,0.875,0.125,0.75,0.5,0.875,0.5,0.875,0.875,1}};
 
-const std::vector<double> rg5_perimeter = stdvector16(0,sqrt(0.5),sqrt(0.5),1,sqrt(0.5),1,sqrt(2),sqrt(0.5),sqrt(0.5),sqrt(2),1,sqrt(0.5),1,sqrt(0.5),sqrt(0.5),0);
+constexpr std::array<double,16> rg5_perimeter = {{0,sqrt_1_2,sqrt_1_2,1,sqrt_1_2,1,sqrt_2,sqrt_1_2,sqrt_1_2,sqrt_2,1,sqrt_1_2,1,sqrt_1_2,sqrt_1_2,0}};
 
-const std::vector<double> rg5_euler = stdvector16(0,0.25,0.25,0,0.25,0,-0.5,-0.25,0.25,-0.5,0,-0.25,0,-0.25,-0.25,0);
+constexpr std::array<double,16> rg5_euler = {{0,0.25,0.25,0,0.25,0,-0.5,-0.25,0.25,-0.5,0,-0.25,0,-0.25,-0.25,0}};
 
-const std::vector<double> rg5_w102_xx = stdvector16(0,sqrt(0.125),sqrt(0.125),0,sqrt(0.125),1,sqrt(0.5),sqrt(0.125),sqrt(0.125),sqrt(0.5),1,sqrt(0.125),0,sqrt(0.125),sqrt(0.125),0);
+constexpr std::array<double,16> rg5_w102_xx = {{0,sqrt_1_8,sqrt_1_8,0,sqrt_1_8,1,sqrt_1_2,sqrt_1_8,sqrt_1_8,sqrt_1_2,1,sqrt_1_8,0,sqrt_1_8,sqrt_1_8,0}};
 
-const std::vector<double> rg5_w102_xy = stdvector16(0,-sqrt(0.125),sqrt(0.125),0,sqrt(0.125),0,-sqrt(0.5),-sqrt(0.125),-sqrt(0.125),sqrt(0.5),0,sqrt(0.125),0,sqrt(0.125),-sqrt(0.125),0);
+constexpr std::array<double,16> rg5_w102_xy = {{0,-sqrt_1_8,sqrt_1_8,0,sqrt_1_8,0,-sqrt_1_2,-sqrt_1_8,-sqrt_1_8,sqrt_1_2,0,sqrt_1_8,0,sqrt_1_8,-sqrt_1_8,0}};
 
-const std::vector<double> rg5_w102_yy = stdvector16(0,sqrt(0.125),sqrt(0.125),1,sqrt(0.125),0,sqrt(0.5),sqrt(0.125),sqrt(0.125),sqrt(0.5),0,sqrt(0.125),1,sqrt(0.125),sqrt(0.125),0);
+constexpr std::array<double,16> rg5_w102_yy = {{0,sqrt_1_8,sqrt_1_8,1,sqrt_1_8,0,sqrt_1_2,sqrt_1_8,sqrt_1_8,sqrt_1_2,0,sqrt_1_8,1,sqrt_1_8,sqrt_1_8,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 1
-const std::vector<double> rg1_area = stdvector16(0,0.125,0,0.25,0,0.25,0.125,0.25,0,0.25,0,0.25,0,0.25,0.125,0.25);
+constexpr std::array<double,16> rg1_area = {{0,0.125,0,0.25,0,0.25,0.125,0.25,0,0.25,0,0.25,0,0.25,0.125,0.25}};
 
-const std::vector<double> rg1_perimeter = stdvector16(0,sqrt(0.5),0,0.5,0,0.5,sqrt(0.5),0,0,0,0,0,0,0,sqrt(0.5),0);
+constexpr std::array<double,16> rg1_perimeter = {{0,sqrt_1_2,0,0.5,0,0.5,sqrt_1_2,0,0,0,0,0,0,0,sqrt_1_2,0}};
 
-const std::vector<double> rg1_euler = stdvector16(0,0.25,0,0,0,0,0,0,0,-0.25,0,-0.125,0,-0.125,0,0);
+constexpr std::array<double,16> rg1_euler = {{0,0.25,0,0,0,0,0,0,0,-0.25,0,-0.125,0,-0.125,0,0}};
 
-const std::vector<double> rg1_w102_xx = stdvector16(0,sqrt(0.125),0,0,0,0.5,sqrt(0.125),0,0,0,0,0,0,0,sqrt(0.125),0);
+constexpr std::array<double,16> rg1_w102_xx = {{0,sqrt_1_8,0,0,0,0.5,sqrt_1_8,0,0,0,0,0,0,0,sqrt_1_8,0}};
 
-const std::vector<double> rg1_w102_xy = stdvector16(0,-sqrt(0.125),0,0,0,0,-sqrt(0.125),0,0,0,0,0,0,0,-sqrt(0.125),0);
+constexpr std::array<double,16> rg1_w102_xy = {{0,-sqrt_1_8,0,0,0,0,-sqrt_1_8,0,0,0,0,0,0,0,-sqrt_1_8,0}};
 
-const std::vector<double> rg1_w102_yy = stdvector16(0,sqrt(0.125),0,0.5,0,0,sqrt(0.125),0,0,0,0,0,0,0,sqrt(0.125),0);
+constexpr std::array<double,16> rg1_w102_yy = {{0,sqrt_1_8,0,0.5,0,0,sqrt_1_8,0,0,0,0,0,0,0,sqrt_1_8,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 3
-const std::vector<double> rg3_area = stdvector16(0,0,0.125,0.25,0,0,0.25,0.25,0,0.125,0.25,0.25,0,0.125,0.25,0.25);
+constexpr std::array<double,16> rg3_area = {{0,0,0.125,0.25,0,0,0.25,0.25,0,0.125,0.25,0.25,0,0.125,0.25,0.25}};
 
-const std::vector<double> rg3_perimeter = stdvector16(0,0,sqrt(0.5),0.5,0,0,0,0,0,sqrt(0.5),0.5,0,0,sqrt(0.5),0,0);
+constexpr std::array<double,16> rg3_perimeter = {{0,0,sqrt_1_2,0.5,0,0,0,0,0,sqrt_1_2,0.5,0,0,sqrt_1_2,0,0}};
 
-const std::vector<double> rg3_euler = stdvector16(0,0,0.25,0,0,0,-0.25,-0.125,0,0,0,0,0,0,-0.125,0);
+constexpr std::array<double,16> rg3_euler = {{0,0,0.25,0,0,0,-0.25,-0.125,0,0,0,0,0,0,-0.125,0}};
 
-const std::vector<double> rg3_w102_xx = stdvector16(0,0,sqrt(0.125),0,0,0,0,0,0,sqrt(0.125),0.5,0,0,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg3_w102_xx = {{0,0,sqrt_1_8,0,0,0,0,0,0,sqrt_1_8,0.5,0,0,sqrt_1_8,0,0}};
 
-const std::vector<double> rg3_w102_xy = stdvector16(0,0,sqrt(0.125),0,0,0,0,0,0,sqrt(0.125),0,0,0,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg3_w102_xy = {{0,0,sqrt_1_8,0,0,0,0,0,0,sqrt_1_8,0,0,0,sqrt_1_8,0,0}};
 
-const std::vector<double> rg3_w102_yy = stdvector16(0,0,sqrt(0.125),0.5,0,0,0,0,0,sqrt(0.125),0,0,0,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg3_w102_yy = {{0,0,sqrt_1_8,0.5,0,0,0,0,0,sqrt_1_8,0,0,0,sqrt_1_8,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 7
-const std::vector<double> rg7_area = stdvector16(0,0,0,0,0.125,0.25,0.25,0.25,0,0.125,0,0.125,0.25,0.25,0.25,0.25);
+constexpr std::array<double,16> rg7_area = {{0,0,0,0,0.125,0.25,0.25,0.25,0,0.125,0,0.125,0.25,0.25,0.25,0.25}};
 
-const std::vector<double> rg7_perimeter = stdvector16(0,0,0,0,sqrt(0.5),0.5,0,0,0,sqrt(0.5),0,sqrt(0.5),0.5,0,0,0);
+constexpr std::array<double,16> rg7_perimeter = {{0,0,0,0,sqrt_1_2,0.5,0,0,0,sqrt_1_2,0,sqrt_1_2,0.5,0,0,0}};
 
-const std::vector<double> rg7_euler = stdvector16(0,0,0,0,0.25,0,-0.25,-0.125,0,0,0,0,0,0,-0.125,0);
+constexpr std::array<double,16> rg7_euler = {{0,0,0,0,0.25,0,-0.25,-0.125,0,0,0,0,0,0,-0.125,0}};
 
-const std::vector<double> rg7_w102_xx = stdvector16(0,0,0,0,sqrt(0.125),0.5,0,0,0,sqrt(0.125),0,sqrt(0.125),0,0,0,0);
+constexpr std::array<double,16> rg7_w102_xx = {{0,0,0,0,sqrt_1_8,0.5,0,0,0,sqrt_1_8,0,sqrt_1_8,0,0,0,0}};
 
-const std::vector<double> rg7_w102_xy = stdvector16(0,0,0,0,sqrt(0.125),0,0,0,0,sqrt(0.125),0,sqrt(0.125),0,0,0,0);
+constexpr std::array<double,16> rg7_w102_xy = {{0,0,0,0,sqrt_1_8,0,0,0,0,sqrt_1_8,0,sqrt_1_8,0,0,0,0}};
 
-const std::vector<double> rg7_w102_yy = stdvector16(0,0,0,0,sqrt(0.125),0,0,0,0,sqrt(0.125),0,sqrt(0.125),0.5,0,0,0);
+constexpr std::array<double,16> rg7_w102_yy = {{0,0,0,0,sqrt_1_8,0,0,0,0,sqrt_1_8,0,sqrt_1_8,0.5,0,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 9
-const std::vector<double> rg9_area = stdvector16(0,0,0,0,0,0,0.125,0.125,0.125,0.25,0.25,0.25,0.25,0.25,0.25,0.25);
+constexpr std::array<double,16> rg9_area = {{0,0,0,0,0,0,0.125,0.125,0.125,0.25,0.25,0.25,0.25,0.25,0.25,0.25}};
 
-const std::vector<double> rg9_perimeter = stdvector16(0,0,0,0,0,0,sqrt(0.5),sqrt(0.5),sqrt(0.5),0,0.5,0,0.5,0,0,0);
+constexpr std::array<double,16> rg9_perimeter = {{0,0,0,0,0,0,sqrt_1_2,sqrt_1_2,sqrt_1_2,0,0.5,0,0.5,0,0,0}};
 
-const std::vector<double> rg9_euler = stdvector16(0,0,0,0,0,0,0,0,0.25,-0.25,0,-0.125,0,-0.125,0,0);
+constexpr std::array<double,16> rg9_euler = {{0,0,0,0,0,0,0,0,0.25,-0.25,0,-0.125,0,-0.125,0,0}};
 
-const std::vector<double> rg9_w102_xx = stdvector16(0,0,0,0,0,0,sqrt(0.125),sqrt(0.125),sqrt(0.125),0,0.5,0,0,0,0,0);
+constexpr std::array<double,16> rg9_w102_xx = {{0,0,0,0,0,0,sqrt_1_8,sqrt_1_8,sqrt_1_8,0,0.5,0,0,0,0,0}};
 
-const std::vector<double> rg9_w102_xy = stdvector16(0,0,0,0,0,0,-sqrt(0.125),-sqrt(0.125),-sqrt(0.125),0,0,0,0,0,0,0);
+constexpr std::array<double,16> rg9_w102_xy = {{0,0,0,0,0,0,-sqrt_1_8,-sqrt_1_8,-sqrt_1_8,0,0,0,0,0,0,0}};
 
-const std::vector<double> rg9_w102_yy = stdvector16(0,0,0,0,0,0,sqrt(0.125),sqrt(0.125),sqrt(0.125),0,0,0,0.5,0,0,0);
+constexpr std::array<double,16> rg9_w102_yy = {{0,0,0,0,0,0,sqrt_1_8,sqrt_1_8,sqrt_1_8,0,0,0,0.5,0,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 2
-const std::vector<double> rg2_area = stdvector16(0,0.125,0.125,0.5,0,0.25,0.375,0.5,0,0.375,0.25,0.5,0,0.375,0.375,0.5);
+constexpr std::array<double,16> rg2_area = {{0,0.125,0.125,0.5,0,0.25,0.375,0.5,0,0.375,0.25,0.5,0,0.375,0.375,0.5}};
 
-const std::vector<double> rg2_perimeter = stdvector16(0,sqrt(0.5),sqrt(0.5),1,0,0.5,sqrt(0.5),0,0,sqrt(0.5),0.5,0,0,sqrt(0.5),sqrt(0.5),0);
+constexpr std::array<double,16> rg2_perimeter = {{0,sqrt_1_2,sqrt_1_2,1,0,0.5,sqrt_1_2,0,0,sqrt_1_2,0.5,0,0,sqrt_1_2,sqrt_1_2,0}};
 
-const std::vector<double> rg2_euler = stdvector16(0,0.25,0.25,0,0,0,-0.25,-0.125,0,-0.25,0,-0.125,0,-0.125,-0.125,0);
+constexpr std::array<double,16> rg2_euler = {{0,0.25,0.25,0,0,0,-0.25,-0.125,0,-0.25,0,-0.125,0,-0.125,-0.125,0}};
 
-const std::vector<double> rg2_w102_xx = stdvector16(0,sqrt(0.125),sqrt(0.125),0,0,0.5,sqrt(0.125),0,0,sqrt(0.125),0.5,0,0,sqrt(0.125),sqrt(0.125),0);
+constexpr std::array<double,16> rg2_w102_xx = {{0,sqrt_1_8,sqrt_1_8,0,0,0.5,sqrt_1_8,0,0,sqrt_1_8,0.5,0,0,sqrt_1_8,sqrt_1_8,0}};
 
-const std::vector<double> rg2_w102_xy = stdvector16(0,-sqrt(0.125),sqrt(0.125),0,0,0,-sqrt(0.125),0,0,sqrt(0.125),0,0,0,sqrt(0.125),-sqrt(0.125),0);
+constexpr std::array<double,16> rg2_w102_xy = {{0,-sqrt_1_8,sqrt_1_8,0,0,0,-sqrt_1_8,0,0,sqrt_1_8,0,0,0,sqrt_1_8,-sqrt_1_8,0}};
 
-const std::vector<double> rg2_w102_yy = stdvector16(0,sqrt(0.125),sqrt(0.125),1,0,0,sqrt(0.125),0,0,sqrt(0.125),0,0,0,sqrt(0.125),sqrt(0.125),0);
+constexpr std::array<double,16> rg2_w102_yy = {{0,sqrt_1_8,sqrt_1_8,1,0,0,sqrt_1_8,0,0,sqrt_1_8,0,0,0,sqrt_1_8,sqrt_1_8,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 4
-const std::vector<double> rg4_area = stdvector16(0,0.125,0,0.25,0.125,0.5,0.375,0.5,0,0.375,0,0.375,0.25,0.5,0.375,0.5);
+constexpr std::array<double,16> rg4_area = {{0,0.125,0,0.25,0.125,0.5,0.375,0.5,0,0.375,0,0.375,0.25,0.5,0.375,0.5}};
 
-const std::vector<double> rg4_perimeter = stdvector16(0,sqrt(0.5),0,0.5,sqrt(0.5),1,sqrt(0.5),0,0,sqrt(0.5),0,sqrt(0.5),0.5,0,sqrt(0.5),0);
+constexpr std::array<double,16> rg4_perimeter = {{0,sqrt_1_2,0,0.5,sqrt_1_2,1,sqrt_1_2,0,0,sqrt_1_2,0,sqrt_1_2,0.5,0,sqrt_1_2,0}};
 
-const std::vector<double> rg4_euler = stdvector16(0,0.25,0,0,0.25,0,-0.25,-0.125,0,-0.25,0,-0.125,0,-0.125,-0.125,0);
+constexpr std::array<double,16> rg4_euler = {{0,0.25,0,0,0.25,0,-0.25,-0.125,0,-0.25,0,-0.125,0,-0.125,-0.125,0}};
 
-const std::vector<double> rg4_w102_xx = stdvector16(0,sqrt(0.125),0,0,sqrt(0.125),1,sqrt(0.125),0,0,sqrt(0.125),0,sqrt(0.125),0,0,sqrt(0.125),0);
+constexpr std::array<double,16> rg4_w102_xx = {{0,sqrt_1_8,0,0,sqrt_1_8,1,sqrt_1_8,0,0,sqrt_1_8,0,sqrt_1_8,0,0,sqrt_1_8,0}};
 
-const std::vector<double> rg4_w102_xy = stdvector16(0,-sqrt(0.125),0,0,sqrt(0.125),0,-sqrt(0.125),0,0,sqrt(0.125),0,sqrt(0.125),0,0,-sqrt(0.125),0);
+constexpr std::array<double,16> rg4_w102_xy = {{0,-sqrt_1_8,0,0,sqrt_1_8,0,-sqrt_1_8,0,0,sqrt_1_8,0,sqrt_1_8,0,0,-sqrt_1_8,0}};
 
-const std::vector<double> rg4_w102_yy = stdvector16(0,sqrt(0.125),0,0.5,sqrt(0.125),0,sqrt(0.125),0,0,sqrt(0.125),0,sqrt(0.125),0.5,0,sqrt(0.125),0);
+constexpr std::array<double,16> rg4_w102_yy = {{0,sqrt_1_8,0,0.5,sqrt_1_8,0,sqrt_1_8,0,0,sqrt_1_8,0,sqrt_1_8,0.5,0,sqrt_1_8,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 6
-const std::vector<double> rg6_area = stdvector16(0,0,0.125,0.25,0,0,0.375,0.375,0.125,0.375,0.5,0.5,0.25,0.375,0.5,0.5);
+constexpr std::array<double,16> rg6_area = {{0,0,0.125,0.25,0,0,0.375,0.375,0.125,0.375,0.5,0.5,0.25,0.375,0.5,0.5}};
 
-const std::vector<double> rg6_perimeter = stdvector16(0,0,sqrt(0.5),0.5,0,0,sqrt(0.5),sqrt(0.5),sqrt(0.5),sqrt(0.5),1,0,0.5,sqrt(0.5),0,0);
+constexpr std::array<double,16> rg6_perimeter = {{0,0,sqrt_1_2,0.5,0,0,sqrt_1_2,sqrt_1_2,sqrt_1_2,sqrt_1_2,1,0,0.5,sqrt_1_2,0,0}};
 
-const std::vector<double> rg6_euler = stdvector16(0,0,0.25,0,0,0,-0.25,-0.125,0.25,-0.25,0,-0.125,0,-0.125,-0.125,0);
+constexpr std::array<double,16> rg6_euler = {{0,0,0.25,0,0,0,-0.25,-0.125,0.25,-0.25,0,-0.125,0,-0.125,-0.125,0}};
 
-const std::vector<double> rg6_w102_xx = stdvector16(0,0,sqrt(0.125),0,0,0,sqrt(0.125),sqrt(0.125),sqrt(0.125),sqrt(0.125),1,0,0,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg6_w102_xx = {{0,0,sqrt_1_8,0,0,0,sqrt_1_8,sqrt_1_8,sqrt_1_8,sqrt_1_8,1,0,0,sqrt_1_8,0,0}};
 
-const std::vector<double> rg6_w102_xy = stdvector16(0,0,sqrt(0.125),0,0,0,-sqrt(0.125),-sqrt(0.125),-sqrt(0.125),sqrt(0.125),0,0,0,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg6_w102_xy = {{0,0,sqrt_1_8,0,0,0,-sqrt_1_8,-sqrt_1_8,-sqrt_1_8,sqrt_1_8,0,0,0,sqrt_1_8,0,0}};
 
-const std::vector<double> rg6_w102_yy = stdvector16(0,0,sqrt(0.125),0.5,0,0,sqrt(0.125),sqrt(0.125),sqrt(0.125),sqrt(0.125),0,0,0.5,sqrt(0.125),0,0);
+constexpr std::array<double,16> rg6_w102_yy = {{0,0,sqrt_1_8,0.5,0,0,sqrt_1_8,sqrt_1_8,sqrt_1_8,sqrt_1_8,0,0,0.5,sqrt_1_8,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Range 8
-const std::vector<double> rg8_area = stdvector16(0,0,0,0,0.125,0.25,0.375,0.375,0.125,0.375,0.25,0.375,0.5,0.5,0.5,0.5);
+constexpr std::array<double,16> rg8_area = {{0,0,0,0,0.125,0.25,0.375,0.375,0.125,0.375,0.25,0.375,0.5,0.5,0.5,0.5}};
 
-const std::vector<double> rg8_perimeter = stdvector16(0,0,0,0,sqrt(0.5),0.5,sqrt(0.5),sqrt(0.5),sqrt(0.5),sqrt(0.5),0.5,sqrt(0.5),1,0,0,0);
+constexpr std::array<double,16> rg8_perimeter = {{0,0,0,0,sqrt_1_2,0.5,sqrt_1_2,sqrt_1_2,sqrt_1_2,sqrt_1_2,0.5,sqrt_1_2,1,0,0,0}};
 
-const std::vector<double> rg8_euler = stdvector16(0,0,0,0,0.25,0,-0.25,-0.125,0.25,-0.25,0,-0.125,0,-0.125,-0.125,0);
+constexpr std::array<double,16> rg8_euler = {{0,0,0,0,0.25,0,-0.25,-0.125,0.25,-0.25,0,-0.125,0,-0.125,-0.125,0}};
 
-const std::vector<double> rg8_w102_xx = stdvector16(0,0,0,0,sqrt(0.125),0.5,sqrt(0.125),sqrt(0.125),sqrt(0.125),sqrt(0.125),0.5,sqrt(0.125),0,0,0,0);
+constexpr std::array<double,16> rg8_w102_xx = {{0,0,0,0,sqrt_1_8,0.5,sqrt_1_8,sqrt_1_8,sqrt_1_8,sqrt_1_8,0.5,sqrt_1_8,0,0,0,0}};
 
-const std::vector<double> rg8_w102_xy = stdvector16(0,0,0,0,sqrt(0.125),0,-sqrt(0.125),-sqrt(0.125),-sqrt(0.125),sqrt(0.125),0,sqrt(0.125),0,0,0,0);
+constexpr std::array<double,16> rg8_w102_xy = {{0,0,0,0,sqrt_1_8,0,-sqrt_1_8,-sqrt_1_8,-sqrt_1_8,sqrt_1_8,0,sqrt_1_8,0,0,0,0}};
 
-const std::vector<double> rg8_w102_yy = stdvector16(0,0,0,0,sqrt(0.125),0,sqrt(0.125),sqrt(0.125),sqrt(0.125),sqrt(0.125),0,sqrt(0.125),1,0,0,0);
+constexpr std::array<double,16> rg8_w102_yy = {{0,0,0,0,sqrt_1_8,0,sqrt_1_8,sqrt_1_8,sqrt_1_8,sqrt_1_8,0,sqrt_1_8,1,0,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
@@ -164,91 +170,115 @@ const std::vector<double> rg8_w102_yy = stdvector16(0,0,0,0,sqrt(0.125),0,sqrt(0
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 5
-const std::vector<int> rg5_area_pix = stdvector_int16(0,2,2,4,2,4,4,6,2,4,4,6,4,6,6,8);
+constexpr std::array<int,16> rg5_area_pix = {{0,2,2,4,2,4,4,6,2,4,4,6,4,6,6,8}};
 
-const std::vector<int> rg5_perimeter_pix = stdvector_int16(0,8,8,8,8,8,16,8,8,16,8,8,8,8,8,0);
+constexpr std::array<int,16> rg5_perimeter_pix = {{0,8,8,8,8,8,16,8,8,16,8,8,8,8,8,0}};
 
-const std::vector<int> rg5_euler_pix = stdvector_int16(0,2,2,0,2,0,-4,-2,2,-4,0,-2,0,-2,-2,0);
+constexpr std::array<int,16> rg5_euler_pix = {{0,2,2,0,2,0,-4,-2,2,-4,0,-2,0,-2,-2,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 1
-const std::vector<int> rg1_area_pix = stdvector_int16(0,2,0,2,0,2,0,2,0,2,0,2,0,2,0,2);
+constexpr std::array<int,16> rg1_area_pix = {{0,2,0,2,0,2,0,2,0,2,0,2,0,2,0,2}};
 
-const std::vector<int> rg1_perimeter_pix = stdvector_int16(0,8,0,4,0,4,0,0,0,8,0,1/2,0,1/2,0,0);
+constexpr std::array<int,16> rg1_perimeter_pix = {{0,8,0,4,0,4,0,0,0,8,0,1/2,0,1/2,0,0}};
 
-const std::vector<int> rg1_euler_pix = stdvector_int16(0,2,0,0,0,0,0,0,0,-2,0,-1,0,-1,0,0);
+constexpr std::array<int,16> rg1_euler_pix = {{0,2,0,0,0,0,0,0,0,-2,0,-1,0,-1,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 3
-const std::vector<int> rg3_area_pix = stdvector_int16(0,0,2,2,0,0,2,2,0,0,2,2,0,0,2,2);
+constexpr std::array<int,16> rg3_area_pix = {{0,0,2,2,0,0,2,2,0,0,2,2,0,0,2,2}};
 
-const std::vector<int> rg3_perimeter_pix = stdvector_int16(0,0,8,4,0,0,8,4,0,0,4,0,0,0,4,0);
+constexpr std::array<int,16> rg3_perimeter_pix = {{0,0,8,4,0,0,8,4,0,0,4,0,0,0,4,0}};
 
-const std::vector<int> rg3_euler_pix = stdvector_int16(0,0,2,0,0,0,-2,-1,0,0,0,0,0,0,-1,0);
+constexpr std::array<int,16> rg3_euler_pix = {{0,0,2,0,0,0,-2,-1,0,0,0,0,0,0,-1,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 7
-const std::vector<int> rg7_area_pix = stdvector_int16(0,0,0,0,2,2,2,2,0,0,0,0,2,2,2,2);
+constexpr std::array<int,16> rg7_area_pix = {{0,0,0,0,2,2,2,2,0,0,0,0,2,2,2,2}};
 
-const std::vector<int> rg7_perimeter_pix = stdvector_int16(0,0,0,0,8,4,8,4,0,0,0,0,4,0,4,0);
+constexpr std::array<int,16> rg7_perimeter_pix = {{0,0,0,0,8,4,8,4,0,0,0,0,4,0,4,0}};
 
-const std::vector<int> rg7_euler_pix = stdvector_int16(0,0,0,0,2,0,-2,-1,0,0,0,0,0,0,-1,0);
+constexpr std::array<int,16> rg7_euler_pix = {{0,0,0,0,2,0,-2,-1,0,0,0,0,0,0,-1,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 9
-const std::vector<int> rg9_area_pix = stdvector_int16(0,0,0,0,0,0,0,0,2,2,2,2,2,2,2,2);
+constexpr std::array<int,16> rg9_area_pix = {{0,0,0,0,0,0,0,0,2,2,2,2,2,2,2,2}};
 
-const std::vector<int> rg9_perimeter_pix = stdvector_int16(0,0,0,0,0,0,0,0,8,8,4,4,4,4,0,0);
+constexpr std::array<int,16> rg9_perimeter_pix = {{0,0,0,0,0,0,0,0,8,8,4,4,4,4,0,0}};
 
-const std::vector<int> rg9_euler_pix = stdvector_int16(0,0,0,0,0,0,0,0,2,-2,0,-1,0,-1,0,0);
+constexpr std::array<int,16> rg9_euler_pix = {{0,0,0,0,0,0,0,0,2,-2,0,-1,0,-1,0,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 2
-const std::vector<int> rg2_area_pix = stdvector_int16(0,2,2,4,0,2,2,4,0,2,2,4,0,2,2,4);
+constexpr std::array<int,16> rg2_area_pix = {{0,2,2,4,0,2,2,4,0,2,2,4,0,2,2,4}};
 
-const std::vector<int> rg2_perimeter_pix = stdvector_int16(0,8,8,8,0,4,8,4,0,8,4,4,0,4,4,0);
+constexpr std::array<int,16> rg2_perimeter_pix = {{0,8,8,8,0,4,8,4,0,8,4,4,0,4,4,0}};
 
-const std::vector<int> rg2_euler_pix = stdvector_int16(0,2,2,0,0,0,-2,-1,0,-2,0,-1,0,-1,-1,0);
+constexpr std::array<int,16> rg2_euler_pix = {{0,2,2,0,0,0,-2,-1,0,-2,0,-1,0,-1,-1,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 4
-const std::vector<int> rg4_area_pix = stdvector_int16(0,2,0,2,2,4,2,4,0,2,0,2,2,4,2,4);
+constexpr std::array<int,16> rg4_area_pix = {{0,2,0,2,2,4,2,4,0,2,0,2,2,4,2,4}};
 
-const std::vector<int> rg4_perimeter_pix = stdvector_int16(0,8,0,4,8,8,8,4,0,8,0,4,4,4,4,0);
+constexpr std::array<int,16> rg4_perimeter_pix = {{0,8,0,4,8,8,8,4,0,8,0,4,4,4,4,0}};
 
-const std::vector<int> rg4_euler_pix = stdvector_int16(0,2,0,0,2,0,-2,-1,0,-2,0,-1,0,-1,-1,0);
+constexpr std::array<int,16> rg4_euler_pix = {{0,2,0,0,2,0,-2,-1,0,-2,0,-1,0,-1,-1,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 6
-const std::vector<int> rg6_area_pix = stdvector_int16(0,0,2,2,0,0,2,2,2,2,4,4,2,2,4,4);
+constexpr std::array<int,16> rg6_area_pix = {{0,0,2,2,0,0,2,2,2,2,4,4,2,2,4,4}};
 
-const std::vector<int> rg6_perimeter_pix = stdvector_int16(0,0,8,4,0,0,8,4,8,8,8,4,4,4,4,0);
+constexpr std::array<int,16> rg6_perimeter_pix = {{0,0,8,4,0,0,8,4,8,8,8,4,4,4,4,0}};
 
-const std::vector<int> rg6_euler_pix = stdvector_int16(0,0,2,0,0,0,-2,-1,2,-2,0,-1,0,-1,-1,0);
+constexpr std::array<int,16> rg6_euler_pix = {{0,0,2,0,0,0,-2,-1,2,-2,0,-1,0,-1,-1,0}};
 // ------------------------------------------------------------------------------------------------------- //
 
 
 // ------------------------------------------------------------------------------------------------------- //
 // Pix: Range 8
-const std::vector<int> rg8_area_pix = stdvector_int16(0,0,0,0,2,2,2,2,2,2,2,2,4,4,4,4);
+constexpr std::array<int,16> rg8_area_pix = {{0,0,0,0,2,2,2,2,2,2,2,2,4,4,4,4}};
+
+constexpr std::array<int,16> rg8_perimeter_pix = {{0,0,0,0,8,4,8,4,8,8,4,4,8,4,4,0}};
+
+constexpr std::array<int,16> rg8_euler_pix = {{0,0,0,0,2,0,-2,-1,2,-2,0,-1,0,-1,-1,0}};
+// ------------------------------------------------------------------------------------------------------- //
+
+// ------------------------------------------------------------------------------------------------------- //
+// Look-up tables of each functional for the ranges 1...9 (index 0 is the bulk, as range 5)
+template < typename number >
+using RangeTables = std::array< std::array<number,16>, 10 >;
+
+constexpr RangeTables<double> area_tables = {{ rg5_area, rg1_area, rg2_area, rg3_area, rg4_area, rg5_area, rg6_area, rg7_area, rg8_area, rg9_area }};
+
+constexpr RangeTables<double> perimeter_tables = {{ rg5_perimeter, rg1_perimeter, rg2_perimeter, rg3_perimeter, rg4_perimeter, rg5_perimeter, rg6_perimeter, rg7_perimeter, rg8_perimeter, rg9_perimeter }};
+
+constexpr RangeTables<double> euler_tables = {{ rg5_euler, rg1_euler, rg2_euler, rg3_euler, rg4_euler, rg5_euler, rg6_euler, rg7_euler, rg8_euler, rg9_euler }};
+
+constexpr RangeTables<double> w102_xx_tables = {{ rg5_w102_xx, rg1_w102_xx, rg2_w102_xx, rg3_w102_xx, rg4_w102_xx, rg5_w102_xx, rg6_w102_xx, rg7_w102_xx, rg8_w102_xx, rg9_w102_xx }};
+
+constexpr RangeTables<double> w102_xy_tables = {{ rg5_w102_xy, rg1_w102_xy, rg2_w102_xy, rg3_w102_xy, rg4_w102_xy, rg5_w102_xy, rg6_w102_xy, rg7_w102_xy, rg8_w102_xy, rg9_w102_xy }};
+
+constexpr RangeTables<double> w102_yy_tables = {{ rg5_w102_yy, rg1_w102_yy, rg2_w102_yy, rg3_w102_yy, rg4_w102_yy, rg5_w102_yy, rg6_w102_yy, rg7_w102_yy, rg8_w102_yy, rg9_w102_yy }};
+
+constexpr RangeTables<int> area_pix_tables = {{ rg5_area_pix, rg1_area_pix, rg2_area_pix, rg3_area_pix, rg4_area_pix, rg5_area_pix, rg6_area_pix, rg7_area_pix, rg8_area_pix, rg9_area_pix }};
 
-const std::vector<int> rg8_perimeter_pix = stdvector_int16(0,0,0,0,8,4,8,4,8,8,4,4,8,4,4,0);
+constexpr RangeTables<int> perimeter_pix_tables = {{ rg5_perimeter_pix, rg1_perimeter_pix, rg2_perimeter_pix, rg3_perimeter_pix, rg4_perimeter_pix, rg5_perimeter_pix, rg6_perimeter_pix, rg7_perimeter_pix, rg8_perimeter_pix, rg9_perimeter_pix }};
 
-const std::vector<int> rg8_euler_pix = stdvector_int16(0,0,0,0,2,0,-2,-1,2,-2,0,-1,0,-1,-1,0);
+constexpr RangeTables<int> euler_pix_tables = {{ rg5_euler_pix, rg1_euler_pix, rg2_euler_pix, rg3_euler_pix, rg4_euler_pix, rg5_euler_pix, rg6_euler_pix, rg7_euler_pix, rg8_euler_pix, rg9_euler_pix }};
 // ------------------------------------------------------------------------------------------------------- //
 
 /*
@@ -5,6 +5,13 @@
  *      Author: mklatt
  */
 
+#include <algorithm>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 #include "minkowski.h"
 
 // Minkowski Sky Map Tools
@@ -41,12 +48,16 @@ unsigned convert(const bool &first, const bool &second, const bool &third, const
   return first + 2*second + 4*third + 8*fourth;
 }
 
-// Minus sampling boundary condition
-double area_mbc(const BinField<bool> &sample,
-                const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+// Pixel xi of a bit-packed row of a BinField<bool>
+static inline bool bit(const uint64_t *row, const unsigned &xi)
 {
-  double total = 0;
+  return (row[xi >> 6] >> (xi & 63)) & 1;
+}
 
+// Exit unless the Nx x Ny SubBinField at (xi,yi) lies inside of sample
+static void check_subfield(const BinField<bool> &sample,
+                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
   if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
     std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
               << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
@@ -54,2579 +65,1209 @@ double area_mbc(const BinField<bool> &sample,
               << std::endl;
     exit(-1);
   }
+}
 
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// -----------------------
+// Row kernel of the window histograms: the numbers of the 2x2 windows per configuration between
+// two bit-packed rows
+//
+// The window whose right pixels are the bits j of low and up has its left pixels at j-1,
+// which are the bits of the shifted words (with the carry from the previous word).
+// The four pixels yield four pairs of masks, whose products are the masks of the 16 configurations,
+// so that a word of 64 windows costs 16 popcounts. The words inside of the range of windows are
+// counted several words at a time with SSE2, AVX2, or AVX-512 (with VPOPCNTDQ), whichever is the
+// widest one the CPU supports; the instruction set is chosen at runtime, so that the same
+// binary runs on every x86-64 CPU (and all kernels can be checked on one CPU, see set_histogram_kernel).
+// Without x86 the words are counted one by one.
+// -----------------------
+
+// Count the windows with right pixels in the word wi whose bits are set in inside
+static inline void count_word(long counts[16], const uint64_t *low, const uint64_t *up,
+                              const unsigned &wi, const uint64_t &inside)
+{
+  const uint64_t right_low = low[wi];
+  const uint64_t left_low = (low[wi] << 1) | (wi > 0 ? low[wi-1] >> 63 : 0);
+  const uint64_t right_up = up[wi];
+  const uint64_t left_up = (up[wi] << 1) | (wi > 0 ? up[wi-1] >> 63 : 0);
+
+  // lower and upper pixels: configurations 0...3 (times 1 and 4)
+  const uint64_t lower[4] = { inside & ~right_low & ~left_low, inside & right_low & ~left_low,
+                              inside & ~right_low & left_low, inside & right_low & left_low };
+  const uint64_t upper[4] = { ~right_up & ~left_up, right_up & ~left_up,
+                              ~right_up & left_up, right_up & left_up };
+
+  for(unsigned u = 0; u < 4; u++)
+    for(unsigned l = 0; l < 4; l++)
+      counts[4*u + l] += popcount(lower[l] & upper[u]);
+}
 
-      X++;
-    }
+// Count all windows with right pixels in the words w0...w1-1 (w0 > 0)
+typedef void (*CountWords)(long counts[16], const uint64_t *low, const uint64_t *up,
+                           const unsigned &w0, const unsigned &w1);
 
-  // Range 9
-  total += rg9_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+static void count_words_scalar(long counts[16], const uint64_t *low, const uint64_t *up,
+                               const unsigned &w0, const unsigned &w1)
+{
+  for(unsigned wi = w0; wi < w1; wi++)
+    count_word(counts, low, up, wi, ~uint64_t(0));
+}
 
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
+#if defined(__x86_64__) || defined(__i386__)
+// The vector kernels keep one vector of 64-bit counts per configuration, whose lanes
+// are added up at the end; the remaining words are counted one by one.
+__attribute__((target("sse2")))
+static void count_words_sse2(long counts[16], const uint64_t *low, const uint64_t *up,
+                             const unsigned &w0, const unsigned &w1)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi32(-1);
+  const __m128i m1 = _mm_set1_epi8(0x55);
+  const __m128i m2 = _mm_set1_epi8(0x33);
+  const __m128i m4 = _mm_set1_epi8(0x0f);
+
+  __m128i sums[16];
+  for(unsigned c = 0; c < 16; c++)
+    sums[c] = zero;
+
+  unsigned wi = w0;
+  for(; wi + 2 <= w1; wi += 2)
+    {
+      const __m128i right_low = _mm_loadu_si128((const __m128i*)(low+wi));
+      const __m128i left_low = _mm_or_si128(_mm_slli_epi64(right_low, 1),
+                                            _mm_srli_epi64(_mm_loadu_si128((const __m128i*)(low+wi-1)), 63));
+      const __m128i right_up = _mm_loadu_si128((const __m128i*)(up+wi));
+      const __m128i left_up = _mm_or_si128(_mm_slli_epi64(right_up, 1),
+                                           _mm_srli_epi64(_mm_loadu_si128((const __m128i*)(up+wi-1)), 63));
+
+      const __m128i lower[4] = { _mm_andnot_si128(_mm_or_si128(right_low, left_low), ones),
+                                 _mm_andnot_si128(left_low, right_low),
+                                 _mm_andnot_si128(right_low, left_low),
+                                 _mm_and_si128(right_low, left_low) };
+      const __m128i upper[4] = { _mm_andnot_si128(_mm_or_si128(right_up, left_up), ones),
+                                 _mm_andnot_si128(left_up, right_up),
+                                 _mm_andnot_si128(right_up, left_up),
+                                 _mm_and_si128(right_up, left_up) };
+
+      for(unsigned u = 0; u < 4; u++)
+        for(unsigned l = 0; l < 4; l++)
+          {
+            // bit counts per byte, summed per 64-bit lane
+            __m128i x = _mm_and_si128(lower[l], upper[u]);
+            x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi64(x, 1), m1));
+            x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi64(x, 2), m2));
+            x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi64(x, 4)), m4);
+            sums[4*u + l] = _mm_add_epi64(sums[4*u + l], _mm_sad_epu8(x, zero));
+          }
+    }
+
+  for(unsigned c = 0; c < 16; c++)
+    {
+      uint64_t lanes[2];
+      _mm_storeu_si128((__m128i*)lanes, sums[c]);
+      counts[c] += lanes[0] + lanes[1];
+    }
+  count_words_scalar(counts, low, up, wi, w1);
+}
 
-      // Range 4
-      X = 0;
-      total += rg4_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+__attribute__((target("avx2")))
+static void count_words_avx2(long counts[16], const uint64_t *low, const uint64_t *up,
+                             const unsigned &w0, const unsigned &w1)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i m4 = _mm256_set1_epi8(0x0f);
+  // bit counts of the nibbles
+  const __m256i nibble = _mm256_setr_epi8(0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,
+                                          0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4);
+
+  __m256i sums[16];
+  for(unsigned c = 0; c < 16; c++)
+    sums[c] = zero;
+
+  unsigned wi = w0;
+  for(; wi + 4 <= w1; wi += 4)
+    {
+      const __m256i right_low = _mm256_loadu_si256((const __m256i*)(low+wi));
+      const __m256i left_low = _mm256_or_si256(_mm256_slli_epi64(right_low, 1),
+                                               _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)(low+wi-1)), 63));
+      const __m256i right_up = _mm256_loadu_si256((const __m256i*)(up+wi));
+      const __m256i left_up = _mm256_or_si256(_mm256_slli_epi64(right_up, 1),
+                                              _mm256_srli_epi64(_mm256_loadu_si256((const __m256i*)(up+wi-1)), 63));
+
+      const __m256i lower[4] = { _mm256_andnot_si256(_mm256_or_si256(right_low, left_low), ones),
+                                 _mm256_andnot_si256(left_low, right_low),
+                                 _mm256_andnot_si256(right_low, left_low),
+                                 _mm256_and_si256(right_low, left_low) };
+      const __m256i upper[4] = { _mm256_andnot_si256(_mm256_or_si256(right_up, left_up), ones),
+                                 _mm256_andnot_si256(left_up, right_up),
+                                 _mm256_andnot_si256(right_up, left_up),
+                                 _mm256_and_si256(right_up, left_up) };
+
+      for(unsigned u = 0; u < 4; u++)
+        for(unsigned l = 0; l < 4; l++)
+          {
+            // bit counts per byte from the two nibbles, summed per 64-bit lane
+            const __m256i x = _mm256_and_si256(lower[l], upper[u]);
+            const __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(nibble, _mm256_and_si256(x, m4)),
+                                                  _mm256_shuffle_epi8(nibble, _mm256_and_si256(_mm256_srli_epi64(x, 4), m4)));
+            sums[4*u + l] = _mm256_add_epi64(sums[4*u + l], _mm256_sad_epu8(bytes, zero));
+          }
+    }
+
+  for(unsigned c = 0; c < 16; c++)
+    {
+      uint64_t lanes[4];
+      _mm256_storeu_si256((__m256i*)lanes, sums[c]);
+      counts[c] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+  count_words_scalar(counts, low, up, wi, w1);
+}
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
+__attribute__((target("avx512f,avx512vpopcntdq")))
+static void count_words_avx512(long counts[16], const uint64_t *low, const uint64_t *up,
+                               const unsigned &w0, const unsigned &w1)
+{
+  // all lanes (the masked shifts do not depend on an undefined source)
+  const __mmask8 all = 0xFF;
+
+  __m512i sums[16];
+  for(unsigned c = 0; c < 16; c++)
+    sums[c] = _mm512_setzero_si512();
+
+  unsigned wi = w0;
+  for(; wi + 8 <= w1; wi += 8)
+    {
+      const __m512i right_low = _mm512_loadu_si512(low+wi);
+      const __m512i left_low = _mm512_or_si512(_mm512_maskz_slli_epi64(all, right_low, 1),
+                                               _mm512_maskz_srli_epi64(all, _mm512_loadu_si512(low+wi-1), 63));
+      const __m512i right_up = _mm512_loadu_si512(up+wi);
+      const __m512i left_up = _mm512_or_si512(_mm512_maskz_slli_epi64(all, right_up, 1),
+                                              _mm512_maskz_srli_epi64(all, _mm512_loadu_si512(up+wi-1), 63));
+
+      // products of the masks in one instruction each, whose truth table of (right, left, right)
+      // or (right_low, left_low, upper) has a single entry
+      const __m512i upper[4] = { _mm512_ternarylogic_epi64(right_up, left_up, right_up, 0x01),
+                                 _mm512_ternarylogic_epi64(right_up, left_up, right_up, 0x20),
+                                 _mm512_ternarylogic_epi64(right_up, left_up, right_up, 0x04),
+                                 _mm512_ternarylogic_epi64(right_up, left_up, right_up, 0x80) };
+
+      for(unsigned u = 0; u < 4; u++)
         {
-          total += rg5_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-          X++;
+          const __m512i products[4] = { _mm512_ternarylogic_epi64(right_low, left_low, upper[u], 0x02),
+                                        _mm512_ternarylogic_epi64(right_low, left_low, upper[u], 0x20),
+                                        _mm512_ternarylogic_epi64(right_low, left_low, upper[u], 0x08),
+                                        _mm512_ternarylogic_epi64(right_low, left_low, upper[u], 0x80) };
+          for(unsigned l = 0; l < 4; l++)
+            sums[4*u + l] = _mm512_add_epi64(sums[4*u + l], _mm512_popcnt_epi64(products[l]));
         }
-
-      // Range 6
-      total += rg6_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-
-      Y++;
     }
 
-  // -----------------------
-  // TOP ROW
+  for(unsigned c = 0; c < 16; c++)
+    {
+      uint64_t lanes[8];
+      _mm512_storeu_si512(lanes, sums[c]);
+      for(unsigned i = 0; i < 8; i++)
+        counts[c] += lanes[i];
+    }
+  count_words_scalar(counts, low, up, wi, w1);
+}
+#endif
 
-  // Range 1
-  X = 0;
-  total += rg1_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// Kernel of the instruction set name, or 0 if the CPU does not support it
+static CountWords count_words_kernel(const std::string &name)
+{
+  if(name == "scalar")
+    return count_words_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if(name == "avx512" && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vpopcntdq"))
+    return count_words_avx512;
+  if(name == "avx2" && __builtin_cpu_supports("avx2"))
+    return count_words_avx2;
+  if(name == "sse2" && __builtin_cpu_supports("sse2"))
+    return count_words_sse2;
+#endif
+  return 0;
+}
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+std::vector<std::string> histogram_kernels()
+{
+  const std::string names[4] = { "avx512", "avx2", "sse2", "scalar" };
+  std::vector<std::string> supported;
+  for(unsigned ki = 0; ki < 4; ki++)
+    if(count_words_kernel(names[ki]))
+      supported.push_back(names[ki]);
+  return supported;
+}
 
-      X++;
-    }
+// the widest kernel the CPU supports, unless set otherwise
+static std::string count_words_name = histogram_kernels().front();
+static CountWords count_words = count_words_kernel(count_words_name);
 
-  // Range 3
-  total += rg3_area.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+std::string histogram_kernel()
+{
+  return count_words_name;
+}
 
-  return total;
+bool set_histogram_kernel(const std::string &name)
+{
+  CountWords kernel = count_words_kernel(name);
+  if(!kernel)
+    return false;
+  count_words_name = name;
+  count_words = kernel;
+  return true;
 }
 
-double perimeter_mbc(const BinField<bool> &sample,
-                     const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+// Count the windows between two bit-packed rows whose right pixels are first...end-1 (first > 0)
+static void count_row_windows(long counts[16], const uint64_t *low, const uint64_t *up,
+                              const unsigned &first, const unsigned &end)
 {
-  double total = 0;
+  if(end <= first)
+    return;
+
+  // bits first...end-1 of the words first_word...last_word
+  const unsigned first_word = first / 64;
+  const unsigned last_word = (end - 1) / 64;
+  const uint64_t first_mask = ~uint64_t(0) << (first % 64);
+  const uint64_t last_mask = ~uint64_t(0) >> (63 - (end - 1) % 64);
+
+  if(first_word == last_word){
+    count_word(counts, low, up, first_word, first_mask & last_mask);
+    return;
+  }
+  count_word(counts, low, up, first_word, first_mask);
+  count_words(counts, low, up, first_word+1, last_word);
+  count_word(counts, low, up, last_word, last_mask);
+}
 
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
+// -----------------------
+// Look-up table kernel of all functionals and boundary conditions:
+// the sum of the tables of a functional over the 2x2 windows (X,Y) of the Nx x Ny SubBinField at (xi,yi)
+//
+// The window X consists of the pixels x = X-bc::shift and x+1 (and likewise in y). The windows along
+// the sides are looked up in the tables of the ranges
+//   1 2 3   (top row of windows)
+//   4 5 6
+//   7 8 9   (bottom row of windows)
+// and the windows are summed row by row from the bottom, each from left to right.
+// A boundary condition bc provides
+//   shift:               0 if the windows lie inside of the SubBinField, 1 if they reach out by one pixel
+//   outside:             whether there are pixels outside of the SubBinField, which are false
+//   N_windows(N):        the number of windows along a side of N pixels
+//   pixel(row,i,N,x):    pixel x (in -shift...N-shift) of a row of N pixels starting at i
+//   row(sample,white,i,N,y): row y (in -shift...N-shift) of N rows starting at i (white if outside)
+//   coordinate(i,N,x):   coordinate in the sample of pixel x (only if there are no pixels outside)
+// Only the first and last window of a row can reach out of the SubBinField; the windows
+// in between are read directly from the bit-packed rows.
+// -----------------------
+
+// Minus sampling boundary condition: only windows inside of the SubBinField
+struct MinusSamplingBC {
+  static constexpr int shift = 0;
+  static constexpr bool outside = false;
+  static unsigned N_windows(const unsigned &N) { return N-1; }
+  static bool pixel(const uint64_t *row, const unsigned &i, const unsigned &N, const int &x)
+  {
+    return bit(row, i+x);
+  }
+  static unsigned coordinate(const unsigned &i, const unsigned &N, const int &x)
+  {
+    return i+x;
+  }
+  static const uint64_t* row(const BinField<bool> &sample, const uint64_t *white,
+                             const unsigned &i, const unsigned &N, const int &y)
+  {
+    return sample.row(i+y);
+  }
+};
+
+// Periodic boundary condition: the windows wrap around, and the first window of a row (column)
+// is looked up again as the last one
+struct PeriodicBC {
+  static constexpr int shift = 1;
+  static constexpr bool outside = false;
+  static unsigned N_windows(const unsigned &N) { return N+1; }
+  static bool pixel(const uint64_t *row, const unsigned &i, const unsigned &N, const int &x)
+  {
+    return bit(row, i+(x+N)%N);
+  }
+  static unsigned coordinate(const unsigned &i, const unsigned &N, const int &x)
+  {
+    return i+(x+N)%N;
   }
+  static const uint64_t* row(const BinField<bool> &sample, const uint64_t *white,
+                             const unsigned &i, const unsigned &N, const int &y)
+  {
+    return sample.row(i+(y+N)%N);
+  }
+};
+
+// White boundary condition: the windows reach out by one pixel into a false surrounding
+struct WhiteBC {
+  static constexpr int shift = 1;
+  static constexpr bool outside = true;
+  static unsigned N_windows(const unsigned &N) { return N+1; }
+  static bool pixel(const uint64_t *row, const unsigned &i, const unsigned &N, const int &x)
+  {
+    return (x >= 0 && x < int(N)) ? bit(row, i+x) : false;
+  }
+  static const uint64_t* row(const BinField<bool> &sample, const uint64_t *white,
+                             const unsigned &i, const unsigned &N, const int &y)
+  {
+    return (y >= 0 && y < int(N)) ? sample.row(i+y) : white;
+  }
+};
+
+// Visit the windows (X,Y) of the Nx x Ny SubBinField at (xi,yi) in the order above and pass
+// the range (1...9) and configuration of each of them to accumulator.add(range, conf)
+// (only the band of rows of windows first_Y...end_Y-1, if given)
+template < typename bc, typename accumulator >
+static void VisitWindows(const BinField<bool> &sample,
+                         const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                         accumulator &windows, const unsigned &first_Y = 0, const unsigned &end_Y = unsigned(-1))
+{
+  const unsigned N_windows_x = bc::N_windows(Nx);
+  const unsigned N_windows_y = bc::N_windows(Ny);
 
-  unsigned X;
-  unsigned Y;
+  std::vector<uint64_t> white(bc::outside ? sample.call_Nw() : 0, 0);
 
+  for(unsigned Y = first_Y; Y < std::min(end_Y, N_windows_y); Y++)
+    {
+      const int y = int(Y) - bc::shift;
+      const uint64_t *low = bc::row(sample, &white[0], yi, Ny, y);
+      const uint64_t *up = bc::row(sample, &white[0], yi, Ny, y+1);
 
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
+      // Range 7, 4, or 1 and the two ranges to its right
+      const unsigned range = (Y == 0) ? 7 : ((Y == N_windows_y-1) ? 1 : 4);
 
-  // Range 7
-  X = 0;
-  total += rg7_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+      int x = -bc::shift;
+      windows.add(range, convert(bc::pixel(low,xi,Nx,x+1),bc::pixel(low,xi,Nx,x),
+                                 bc::pixel(up,xi,Nx,x+1),bc::pixel(up,xi,Nx,x)));
 
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+      // the windows in between, whose right pixels are xi+2-shift...xi+N_windows_x-shift-1
+      if(N_windows_x > 2)
+        windows.add_row(range+1, low, up, xi+2-bc::shift, xi+N_windows_x-bc::shift);
 
-      X++;
+      x = int(N_windows_x-1) - bc::shift;
+      windows.add(range+2, convert(bc::pixel(low,xi,Nx,x+1),bc::pixel(low,xi,Nx,x),
+                                   bc::pixel(up,xi,Nx,x+1),bc::pixel(up,xi,Nx,x)));
     }
+}
 
-  // Range 9
-  total += rg9_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// Accumulators of VisitWindows: the sum of the tables of a functional, and the histogram of the windows
+//   add(range,conf):                 a single window
+//   add_row(range,low,up,first,end): the windows between the rows low and up whose right pixels are first...end-1
+template < typename number, const RangeTables<number> &tables >
+struct SumOfTables {
+  number total;
+  void add(const unsigned &range, const unsigned &conf) { total += tables[range][conf]; }
+  void add_row(const unsigned &range, const uint64_t *low, const uint64_t *up,
+               const unsigned &first, const unsigned &end)
+  {
+    // the window slides to the right: its right pixels become the left ones
+    unsigned conf = convert(bit(low,first-1),false,bit(up,first-1),false);
+    for(unsigned x = first; x < end; x++)
+      {
+        conf = ((conf & 5) << 1) | bit(low,x) | (bit(up,x) << 2);
+        total += tables[range][conf];
+      }
+  }
+};
+
+struct HistogramOfWindows {
+  WindowHistogram &histogram;
+  void add(const unsigned &range, const unsigned &conf) { histogram.counts[range][conf]++; }
+  void add_row(const unsigned &range, const uint64_t *low, const uint64_t *up,
+               const unsigned &first, const unsigned &end)
+  {
+    count_row_windows(histogram.counts[range], low, up, first, end);
+  }
+};
 
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
+template < typename bc, typename number, const RangeTables<number> &tables >
+static number SumOfWindows(const BinField<bool> &sample,
+                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  SumOfTables<number, tables> sum = { 0 };
+  VisitWindows<bc>(sample, xi, yi, Nx, Ny, sum);
+  return sum.total;
+}
 
-      // Range 4
-      X = 0;
-      total += rg4_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// With N_threads > 1 (0 = all cores) the rows of windows are split into horizontal bands, whose
+// windows share the row of pixels along the seam, and each band is counted by its own thread.
+// The counts are integers, so that the histogram and all functionals of it do not depend on N_threads.
+template < typename bc >
+static void Histogram(const BinField<bool> &sample,
+                      const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                      WindowHistogram &histogram, const unsigned &N_threads = 1)
+{
+  for(unsigned range = 0; range < 10; range++)
+    for(unsigned conf = 0; conf < 16; conf++)
+      histogram.counts[range][conf] = 0;
+
+  const unsigned N_windows_y = (Ny > 0) ? bc::N_windows(Ny) : 0;
+  unsigned N_bands = N_threads;
+  if(N_bands == 0)
+    N_bands = std::max(1u, std::thread::hardware_concurrency());
+  N_bands = std::max(1u, std::min(N_bands, N_windows_y));
+
+  if(N_bands == 1){
+    HistogramOfWindows windows = { histogram };
+    VisitWindows<bc>(sample, xi, yi, Nx, Ny, windows);
+    return;
+  }
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+  // band bi: rows of windows start_Y[bi]...start_Y[bi+1]-1
+  std::vector<unsigned> start_Y(N_bands+1);
+  for(unsigned bi = 0; bi <= N_bands; bi++)
+    start_Y[bi] = (unsigned long)(N_windows_y)*bi/N_bands;
+
+  std::vector<WindowHistogram> band(N_bands, WindowHistogram());
+  std::vector<std::thread> pool;
+  for(unsigned bi = 0; bi < N_bands; bi++)
+    pool.push_back(std::thread([&, bi] {
+      HistogramOfWindows windows = { band[bi] };
+      VisitWindows<bc>(sample, xi, yi, Nx, Ny, windows, start_Y[bi], start_Y[bi+1]);
+    }));
+  for(unsigned bi = 0; bi < N_bands; bi++)
+    pool[bi].join();
+
+  for(unsigned bi = 0; bi < N_bands; bi++)
+    for(unsigned range = 0; range < 10; range++)
+      for(unsigned conf = 0; conf < 16; conf++)
+        histogram.counts[range][conf] += band[bi].counts[range][conf];
+}
 
-          X++;
-        }
+MinkowskiValues minkowski_values(const WindowHistogram &histogram)
+{
+  MinkowskiValues values;
+  values.area = functional(histogram, area_tables);
+  values.perimeter = functional(histogram, perimeter_tables);
+  values.euler = functional(histogram, euler_tables);
+  values.w102_xx = functional(histogram, w102_xx_tables);
+  values.w102_xy = functional(histogram, w102_xy_tables);
+  values.w102_yy = functional(histogram, w102_yy_tables);
+  values.delta = sqrt((values.w102_xx-values.w102_yy)*(values.w102_xx-values.w102_yy)+4*values.w102_xy*values.w102_xy);
+  return values;
+}
 
-      // Range 6
-      total += rg6_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// Single traversal
+void histogram_mbc(const BinField<bool> &sample, WindowHistogram &histogram, const unsigned &N_threads)
+{
+  Histogram<MinusSamplingBC>(sample, 0, 0, sample.call_Nx(), sample.call_Ny(), histogram, N_threads);
+}
 
+void histogram_mbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                   WindowHistogram &histogram)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  Histogram<MinusSamplingBC>(sample, xi, yi, Nx, Ny, histogram);
+}
 
-      Y++;
-    }
+void histogram_pbc(const BinField<bool> &sample, WindowHistogram &histogram, const unsigned &N_threads)
+{
+  Histogram<PeriodicBC>(sample, 0, 0, sample.call_Nx(), sample.call_Ny(), histogram, N_threads);
+}
 
-  // -----------------------
-  // TOP ROW
+void histogram_pbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                   WindowHistogram &histogram)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  Histogram<PeriodicBC>(sample, xi, yi, Nx, Ny, histogram);
+}
 
-  // Range 1
-  X = 0;
-  total += rg1_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+MinkowskiValues minkowski_mbc(const BinField<bool> &sample, const unsigned &N_threads)
+{
+  WindowHistogram histogram;
+  histogram_mbc(sample, histogram, N_threads);
+  return minkowski_values(histogram);
+}
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+MinkowskiValues minkowski_mbc(const BinField<bool> &sample,
+                              const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  WindowHistogram histogram;
+  histogram_mbc(sample, xi, yi, Nx, Ny, histogram);
+  return minkowski_values(histogram);
+}
 
-      X++;
-    }
+MinkowskiValues minkowski_pbc(const BinField<bool> &sample, const unsigned &N_threads)
+{
+  WindowHistogram histogram;
+  histogram_pbc(sample, histogram, N_threads);
+  return minkowski_values(histogram);
+}
 
-  // Range 3
-  total += rg3_perimeter.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+MinkowskiValues minkowski_pbc(const BinField<bool> &sample,
+                              const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  WindowHistogram histogram;
+  histogram_pbc(sample, xi, yi, Nx, Ny, histogram);
+  return minkowski_values(histogram);
+}
 
-  return total;
+// Minus sampling boundary condition
+double area_mbc(const BinField<bool> &sample,
+                const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, area_tables>(sample, xi, yi, Nx, Ny);
+}
+
+double perimeter_mbc(const BinField<bool> &sample,
+                     const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, perimeter_tables>(sample, xi, yi, Nx, Ny);
 }
 
 double euler_mbc(const BinField<bool> &sample,
                  const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
 {
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, euler_tables>(sample, xi, yi, Nx, Ny);
+}
 
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
+double w102_xx_mbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, w102_xx_tables>(sample, xi, yi, Nx, Ny);
+}
 
-  // Range 7
-  X = 0;
-  total += rg7_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+double w102_xy_mbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, w102_xy_tables>(sample, xi, yi, Nx, Ny);
+}
 
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+double w102_yy_mbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<MinusSamplingBC, double, w102_yy_tables>(sample, xi, yi, Nx, Ny);
+}
 
-      X++;
-    }
+double delta_mbc(const BinField<bool> &sample,
+                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  // the tensor components from a single traversal
+  return minkowski_mbc(sample, xi, yi, Nx, Ny).delta;
+}
 
-  // Range 9
-  total += rg9_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// Periodic boundary condition
+double area_pbc(const BinField<bool> &sample,
+                const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, area_tables>(sample, xi, yi, Nx, Ny);
+}
 
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
+double perimeter_pbc(const BinField<bool> &sample,
+                     const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, perimeter_tables>(sample, xi, yi, Nx, Ny);
+}
 
-      // Range 4
-      X = 0;
-      total += rg4_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+double euler_pbc(const BinField<bool> &sample,
+                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, euler_tables>(sample, xi, yi, Nx, Ny);
+}
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+double w102_xx_pbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, w102_xx_tables>(sample, xi, yi, Nx, Ny);
+}
 
-          X++;
-        }
+double w102_xy_pbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, w102_xy_tables>(sample, xi, yi, Nx, Ny);
+}
 
-      // Range 6
-      total += rg6_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+double w102_yy_pbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  check_subfield(sample, xi, yi, Nx, Ny);
+  return SumOfWindows<PeriodicBC, double, w102_yy_tables>(sample, xi, yi, Nx, Ny);
+}
 
+double delta_pbc(const BinField<bool> &sample,
+                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  // the tensor components from a single traversal
+  return minkowski_pbc(sample, xi, yi, Nx, Ny).delta;
+}
 
-      Y++;
-    }
+// Sky maps
+MinkowskiSkyMap::MinkowskiSkyMap(const BinField<bool> &sample, const RangeTables<double> &tables) :
+tables_ ( tables ), NX_ ( sample.call_Nx() > 0 ? sample.call_Nx()-1 : 0 ),
+NY_ ( sample.call_Ny() > 0 ? sample.call_Ny()-1 : 0 ),
+conf_ ( std::vector<unsigned char> (NX_*NY_, 0) ),
+bulk_ ( std::vector<double> ((NX_+1)*(NY_+1), 0) ),
+bottom_ ( std::vector<double> (NY_*(NX_+1), 0) ), top_ ( std::vector<double> (NY_*(NX_+1), 0) ),
+left_ ( std::vector<double> (NX_*(NY_+1), 0) ), right_ ( std::vector<double> (NX_*(NY_+1), 0) )
+{
+  for(unsigned Y = 0; Y < NY_; Y++)
+    {
+      const uint64_t *low = sample.row(Y);
+      const uint64_t *up = sample.row(Y+1);
 
-  // -----------------------
-  // TOP ROW
+      // the window slides to the right as in VisitWindows
+      unsigned conf = convert(bit(low,0),false,bit(up,0),false);
+      double bulk = 0;
+      for(unsigned X = 0; X < NX_; X++)
+        {
+          conf = ((conf & 5) << 1) | bit(low,X+1) | (bit(up,X+1) << 2);
+          conf_[Y*NX_+X] = conf;
 
-  // Range 1
-  X = 0;
-  total += rg1_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+          const unsigned ni = Y*(NX_+1)+X;
+          bottom_[ni+1] = bottom_[ni] + tables_[8][conf];
+          top_[ni+1] = top_[ni] + tables_[2][conf];
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+          const unsigned nj = X*(NY_+1)+Y;
+          left_[nj+1] = left_[nj] + tables_[4][conf];
+          right_[nj+1] = right_[nj] + tables_[6][conf];
 
-      X++;
+          bulk += tables_[5][conf];
+          bulk_[(Y+1)*(NX_+1)+X+1] = bulk_[Y*(NX_+1)+X+1] + bulk;
+        }
     }
-
-  // Range 3
-  total += rg3_euler.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  return total;
 }
 
-double w102_xx_mbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+double MinkowskiSkyMap::value(const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny) const
 {
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
+  if(! ((xi+Nx<=NX_+1)&&(yi+Ny<=NY_+1)&&(Nx>2)&&(Ny>2)) ){
+    std::cerr << "ERROR: cannot compute sky map value; recieved wrong dimensions:" << std::endl
+              << "       sample is a " << (NX_+1) << "x" << (NY_+1) << "BinField, but" << std::endl
               << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
               << std::endl;
     exit(-1);
   }
+  // corner windows
+  const unsigned X0 = xi, X1 = xi+Nx-2;
+  const unsigned Y0 = yi, Y1 = yi+Ny-2;
+  double total = tables_[7][conf_[Y0*NX_+X0]] + tables_[9][conf_[Y0*NX_+X1]]
+               + tables_[1][conf_[Y1*NX_+X0]] + tables_[3][conf_[Y1*NX_+X1]];
+
+  // sides without the corners
+  total += bottom_[Y0*(NX_+1)+X1] - bottom_[Y0*(NX_+1)+X0+1];
+  total += top_[Y1*(NX_+1)+X1] - top_[Y1*(NX_+1)+X0+1];
+  total += left_[X0*(NY_+1)+Y1] - left_[X0*(NY_+1)+Y0+1];
+  total += right_[X1*(NY_+1)+Y1] - right_[X1*(NY_+1)+Y0+1];
+
+  // bulk
+  total += bulk_[Y1*(NX_+1)+X1] - bulk_[(Y0+1)*(NX_+1)+X1]
+         - bulk_[Y1*(NX_+1)+X0+1] + bulk_[(Y0+1)*(NX_+1)+X0+1];
+  return total;
+}
 
-  unsigned X;
-  unsigned Y;
+void MinkowskiSkyMap::map(const unsigned &Nx, const unsigned &Ny, BinField<double> &sky_map) const
+{
+  if( (Nx > NX_+1) || (Ny > NY_+1) ||
+      (sky_map.call_Nx() != NX_+2-Nx) || (sky_map.call_Ny() != NY_+2-Ny) ){
+    std::cerr << "ERROR: cannot compute sky map of " << Nx << "x" << Ny << " SubBinFields of a "
+              << (NX_+1) << "x" << (NY_+1) << "BinField on a "
+              << sky_map.call_Nx() << "x" << sky_map.call_Ny() << "BinField;" << std::endl;
+    exit(-1);
+  }
+  for(unsigned xi = 0; xi < sky_map.call_Nx(); xi++)
+    for(unsigned yi = 0; yi < sky_map.call_Ny(); yi++)
+      sky_map.assign(xi, yi, value(xi, yi, Nx, Ny));
+}
 
+void delta_mbc_sky_map(const BinField<bool> &sample, const unsigned &Nx, const unsigned &Ny,
+                       BinField<double> &sky_map)
+{
+  MinkowskiSkyMap w102_xx(sample, w102_xx_tables);
+  MinkowskiSkyMap w102_xy(sample, w102_xy_tables);
+  MinkowskiSkyMap w102_yy(sample, w102_yy_tables);
+  // checks the dimensions
+  w102_xx.map(Nx, Ny, sky_map);
+  for(unsigned xi = 0; xi < sky_map.call_Nx(); xi++)
+    for(unsigned yi = 0; yi < sky_map.call_Ny(); yi++)
+      {
+        const double xx = sky_map.call(xi, yi);
+        const double xy = w102_xy.value(xi, yi, Nx, Ny);
+        const double yy = w102_yy.value(xi, yi, Nx, Ny);
+        sky_map.assign(xi, yi, sqrt((xx-yy)*(xx-yy)+4*xy*xy));
+      }
+}
 
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
+// Threshold sweep
+// Add the changes of configuration of a window in range to the histograms (differences between
+// consecutive thresholds), where the pixels (rl, ll, ru, lu as in convert) are true before index[i]
+static void AddThresholdWindow(std::vector<WindowHistogram> &changes, const unsigned &range,
+                               const unsigned index[4])
+{
+  // the pixels drop out in the order of their indices
+  unsigned order[4] = { 0, 1, 2, 3 };
+  for(unsigned i = 1; i < 4; i++)
+    for(unsigned j = i; j > 0 && index[order[j]] < index[order[j-1]]; j--)
+      std::swap(order[j], order[j-1]);
+
+  unsigned conf = 15;
+  changes[0].counts[range][conf]++;
+  for(unsigned i = 0; i < 4; i++)
+    {
+      const unsigned k = index[order[i]];
+      if(k >= changes.size())
+        break;
+      changes[k].counts[range][conf]--;
+      conf &= ~(1u << order[i]);
+      changes[k].counts[range][conf]++;
+    }
+}
 
-  // Range 7
-  X = 0;
-  total += rg7_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// Windows as in VisitWindows, with the pixels of the field replaced by their threshold indices
+template < typename bc >
+static void ThresholdHistograms(const BinField<double> &field, const std::vector<double> &thresholds,
+                                std::vector<WindowHistogram> &histograms)
+{
+  for(unsigned k = 1; k < thresholds.size(); k++)
+    if(thresholds[k] < thresholds[k-1]){
+      std::cerr << "ERROR: thresholds have to be in ascending order, but threshold " << k
+                << " = " << thresholds[k] << " < " << thresholds[k-1] << ";" << std::endl;
+      exit(-1);
+    }
 
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+  histograms.assign(thresholds.size(), WindowHistogram());
+  if(thresholds.empty())
+    return;
 
-      X++;
-    }
+  const unsigned Nx = field.call_Nx();
+  const unsigned Ny = field.call_Ny();
 
-  // Range 9
-  total += rg9_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+  // number of thresholds below or at the value of each pixel (column by column as in BinField)
+  std::vector<unsigned> index(Nx*Ny);
+  for(unsigned xi = 0; xi < Nx; xi++)
+    for(unsigned yi = 0; yi < Ny; yi++)
+      index[xi*Ny+yi] = std::upper_bound(thresholds.begin(), thresholds.end(), field.call(xi, yi))
+                        - thresholds.begin();
 
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
+  const unsigned N_windows_x = bc::N_windows(Nx);
+  const unsigned N_windows_y = bc::N_windows(Ny);
+
+  unsigned window[4];
+  for(unsigned Y = 0; Y < N_windows_y; Y++)
     {
+      const int y = int(Y) - bc::shift;
+      const unsigned low = bc::coordinate(0, Ny, y);
+      const unsigned up = bc::coordinate(0, Ny, y+1);
 
-      // Range 4
-      X = 0;
-      total += rg4_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+      const unsigned range = (Y == 0) ? 7 : ((Y == N_windows_y-1) ? 1 : 4);
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
+      for(unsigned X = 0; X < N_windows_x; X++)
         {
-          total += rg5_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-          X++;
+          const int x = int(X) - bc::shift;
+          const unsigned left = bc::coordinate(0, Nx, x);
+          const unsigned right = bc::coordinate(0, Nx, x+1);
+          window[0] = index[right*Ny+low];
+          window[1] = index[left*Ny+low];
+          window[2] = index[right*Ny+up];
+          window[3] = index[left*Ny+up];
+
+          // a single window per row is looked up as first and last one (as in VisitWindows)
+          if(X == 0)
+            AddThresholdWindow(histograms, range, window);
+          if(X == N_windows_x-1)
+            AddThresholdWindow(histograms, range+2, window);
+          if(X > 0 && X < N_windows_x-1)
+            AddThresholdWindow(histograms, range+1, window);
         }
+    }
 
-      // Range 6
-      total += rg6_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+  for(unsigned k = 1; k < histograms.size(); k++)
+    for(unsigned range = 1; range < 10; range++)
+      for(unsigned conf = 0; conf < 16; conf++)
+        histograms[k].counts[range][conf] += histograms[k-1].counts[range][conf];
+}
 
+void threshold_histograms_mbc(const BinField<double> &field, const std::vector<double> &thresholds,
+                              std::vector<WindowHistogram> &histograms)
+{
+  ThresholdHistograms<MinusSamplingBC>(field, thresholds, histograms);
+}
 
-      Y++;
-    }
+void threshold_histograms_pbc(const BinField<double> &field, const std::vector<double> &thresholds,
+                              std::vector<WindowHistogram> &histograms)
+{
+  ThresholdHistograms<PeriodicBC>(field, thresholds, histograms);
+}
 
-  // -----------------------
-  // TOP ROW
+std::vector<MinkowskiValues> minkowski_thresholds_mbc(const BinField<double> &field, const std::vector<double> &thresholds)
+{
+  std::vector<WindowHistogram> histograms;
+  threshold_histograms_mbc(field, thresholds, histograms);
+  std::vector<MinkowskiValues> values;
+  for(unsigned k = 0; k < histograms.size(); k++)
+    values.push_back(minkowski_values(histograms[k]));
+  return values;
+}
 
-  // Range 1
-  X = 0;
-  total += rg1_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+std::vector<MinkowskiValues> minkowski_thresholds_pbc(const BinField<double> &field, const std::vector<double> &thresholds)
+{
+  std::vector<WindowHistogram> histograms;
+  threshold_histograms_pbc(field, thresholds, histograms);
+  std::vector<MinkowskiValues> values;
+  for(unsigned k = 0; k < histograms.size(); k++)
+    values.push_back(minkowski_values(histograms[k]));
+  return values;
+}
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+// PIXELIZED DATA
+// Minus sampling boundary condition
+double area_pixelized_mbc(const BinField<bool> &sample,
+                          const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  double total = 0;
 
-      X++;
-    }
+  check_subfield(sample, xi, yi, Nx, Ny);
 
-  // Range 3
-  total += rg3_w102_xx.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
+  for(unsigned ix = xi+1; ix < (xi+Nx-1); ix++)
+    for(unsigned iy = yi+1; iy < (yi+Ny-1); iy++)
+      total += sample.call(ix,iy);
 
   return total;
 }
 
-double w102_xy_mbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+double perimeter_pixelized_mbc(const BinField<bool> &sample,
+                               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
 {
   double total = 0;
 
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  return total;
-}
-
-double w102_yy_mbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_yy.at(convert(sample.call(xi+X+1,yi+Y),sample.call(xi+X,yi+Y),sample.call(xi+X+1,yi+Y+1),sample.call(xi+X,yi+Y+1)));
-
-  return total;
-}
-
-double delta_mbc(const BinField<bool> &sample,
-                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double w102_xx_ = w102_xx_mbc(sample,xi,yi,Nx,Ny);
-  double w102_xy_ = w102_xy_mbc(sample,xi,yi,Nx,Ny);
-  double w102_yy_ = w102_yy_mbc(sample,xi,yi,Nx,Ny);
-
-  return sqrt((w102_xx_-w102_yy_)*(w102_xx_-w102_yy_)+4*w102_xy_*w102_xy_);
-}
-
-// Periodic boundary condition
-double area_pbc(const BinField<bool> &sample,
-                const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_area.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_area.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_area.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_area.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_area.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_area.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_area.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_area.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_area.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double perimeter_pbc(const BinField<bool> &sample,
-                     const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_perimeter.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_perimeter.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_perimeter.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_perimeter.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_perimeter.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_perimeter.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_perimeter.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_perimeter.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_perimeter.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double euler_pbc(const BinField<bool> &sample,
-                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_euler.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_euler.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_euler.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_euler.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_euler.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_euler.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_euler.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_euler.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_euler.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double w102_xx_pbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xx.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_xx.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xx.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xx.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_xx.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xx.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xx.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_xx.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xx.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double w102_xy_pbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xy.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_xy.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xy.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_xy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xy.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_xy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xy.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double w102_yy_pbc(const BinField<bool> &sample,
-                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_yy.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_yy.at(convert(sample.call(xi+X,yi+Ny-1),sample.call(xi+X-1,yi+Ny-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_yy.at(convert(sample.call(xi,yi+Ny-1),sample.call(xi+Nx-1,yi+Ny-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_yy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_yy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi+Y),sample.call(xi+X-1,yi+Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_yy.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi+Y),sample.call(xi+Nx-1,yi+Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_yy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+Nx-1,yi)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_yy.at(convert(sample.call(xi+X,yi+Y-1),sample.call(xi+X-1,yi+Y-1),sample.call(xi+X,yi),sample.call(xi+X-1,yi)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_yy.at(convert(sample.call(xi,yi+Y-1),sample.call(xi+Nx-1,yi+Y-1),sample.call(xi,yi),sample.call(xi+Nx-1,yi)));
-
-  return total;
-}
-
-double delta_pbc(const BinField<bool> &sample,
-                 const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double w102_xx_ = w102_xx_pbc(sample,xi,yi,Nx,Ny);
-  double w102_xy_ = w102_xy_pbc(sample,xi,yi,Nx,Ny);
-  double w102_yy_ = w102_yy_pbc(sample,xi,yi,Nx,Ny);
-
-  return sqrt((w102_xx_-w102_yy_)*(w102_xx_-w102_yy_)+4*w102_xy_*w102_xy_);
-}
-
-// PIXELIZED DATA
-// Minus sampling boundary condition
-double area_pixelized_mbc(const BinField<bool> &sample,
-                          const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  for(unsigned ix = xi+1; ix < (xi+Nx-1); ix++)
-    for(unsigned iy = yi+1; iy < (yi+Ny-1); iy++)
-      total += sample.call(ix,iy);
-
-  return total;
-}
-
-double perimeter_pixelized_mbc(const BinField<bool> &sample,
-                               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned ix = xi;
-  unsigned iy = yi;
-  for(iy = yi+1; iy < (yi+Ny-1); iy++)
-    total += ( (sample.call(ix,iy)==false) && sample.call(ix+1,iy) );
-
-  ix = xi+Nx-2;
-  for(iy = yi+1; iy < (yi+Ny-1); iy++)
-    total += ( (sample.call(ix+1,iy)==false) && sample.call(ix,iy) );
-
-  for(ix = xi+1; ix < (xi+Nx-2); ix++)
-    for(iy = yi+1; iy < (yi+Ny-1); iy++)
-      total += ( (sample.call(ix+1,iy)==false) && sample.call(ix,iy) ) + ( (sample.call(ix,iy)==false) && sample.call(ix+1,iy) );
-
-  iy = yi;
-  for(ix = xi+1; ix < (xi+Nx-1); ix++)
-    total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy+1) );
-
-  iy = yi+Ny-2;
-  for(ix = xi+1; ix < (xi+Nx-1); ix++)
-    total += ( (sample.call(ix,iy+1)==false) && sample.call(ix,iy) );
-
-  for(iy = yi+1; iy < (yi+Ny-2); iy++)
-    for(ix = xi+1; ix < (xi+Nx-1); ix++)
-    total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy+1) ) + ( (sample.call(ix,iy+1)==false) && sample.call(ix,iy) );
-
-  return total;
-}
-
-double euler_pixelized_mbc(const BinField<bool> &sample,
-                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  return euler_mbc(sample, xi, yi, Nx, Ny);
-}
-
-// Periodic boundary condition
-double area_pixelized_pbc(const BinField<bool> &sample,
-                          const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  for(unsigned ix = xi; ix < (xi+Nx); ix++)
-    for(unsigned iy = yi; iy < (yi+Ny); iy++)
-      total += sample.call(ix,iy);
-
-  return total;
-}
-
-double perimeter_pixelized_pbc(const BinField<bool> &sample,
-                               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  double total = 0;
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  unsigned ix = xi;
-  unsigned iy = yi;
-  for(iy = yi; iy < yi+Ny; iy++){
-    total += ( (sample.call(Nx-1,iy)==false) && sample.call(0,iy) );
-    total += ( (sample.call(0,iy)==false) && sample.call(Nx-1,iy) );
-  }
-
-  for(ix = xi+1; ix < xi+Nx; ix++)
-    for(iy = yi; iy < yi+Ny; iy++){
-      total += ( (sample.call(ix-1,iy)==false) && sample.call(ix,iy) );
-      total += ( (sample.call(ix,iy)==false) && sample.call(ix-1,iy) );
-    }
-
-  for(ix = xi; ix < xi+Nx; ix++){
-    total += ( (sample.call(ix,Ny-1)==false) && sample.call(ix,0) );
-    total += ( (sample.call(ix,0)==false) && sample.call(ix,Ny-1) );
-  }
-
-  for(iy = yi+1; iy < yi+Ny; iy++)
-    for(ix = xi; ix < xi+Nx; ix++){
-      total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy-1) );
-      total += ( (sample.call(ix,iy-1)==false) && sample.call(ix,iy) );
-    }
-
-  return total;
-}
-
-double euler_pixelized_pbc(const BinField<bool> &sample,
-                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
-{
-  return euler_pbc(sample, xi, yi, Nx, Ny);
-}
-
-// PAPAYA
-void print_pgm(const BinField<bool> &sample,
-               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
-               const std::string &filename, const std::string &prefix_of, const bool &invert)
-{
-
-  if(! ((xi>=0)&&(xi<(sample.call_Nx()-Nx+1))&&(yi>=0)&&(yi<(sample.call_Ny()-Ny+1))&&(Nx>2)&&(Ny>2)) ){
-    std::cerr << "ERROR: cannot compute Minkowski functional value; recieved wrong dimensions:" << std::endl
-              << "       sample is a " << sample.call_Nx() << "x" << sample.call_Ny() << "BinField, but" << std::endl
-              << "       SubBinField is " << Nx << "x" << Ny << " at coordinate (" << xi << "," << yi << ");" << std::endl
-              << std::endl;
-    exit(-1);
-  }
-
-  std::ofstream OutFile( (prefix_of + filename).c_str() );
-  OutFile << "P2" << std::endl;
-  OutFile << Nx << " " << Ny << std::endl;
-  OutFile << "255" << std::endl;
-
-  unsigned truephase = 255, voidphase = 0;
-  if(invert){
-    truephase = 0; voidphase = 255;}
-
-  for(unsigned j = (Ny-1); j < Ny; j--)
-    for(unsigned i = 0; i < Nx; i++)
-      {
-        if( sample.call(i,j) )
-          OutFile << truephase << std::endl;
-        else
-          OutFile << voidphase << std::endl;
-      }
-
-  OutFile.close();
-}
-
-// ---------------------------------------------------------------
-// Only BinField as argument:
-
-// Minus sampling boundary condition
-double area_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_area.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double perimeter_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_perimeter.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double euler_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_euler.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double w102_xx_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xx.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double w102_xy_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double w102_yy_mbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_yy.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-double delta_mbc(const BinField<bool> &sample)
-{
-  double w102_xx_ = w102_xx_mbc(sample);
-  double w102_xy_ = w102_xy_mbc(sample);
-  double w102_yy_ = w102_yy_mbc(sample);
-
-  return sqrt((w102_xx_-w102_yy_)*(w102_xx_-w102_yy_)+4*w102_xy_*w102_xy_);
-}
-
-// Periodic boundary condition
-double area_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_area.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_area.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_area.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_area.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_area.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_area.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_area.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_area.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_area.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double perimeter_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_perimeter.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_perimeter.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_perimeter.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_perimeter.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_perimeter.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_perimeter.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_perimeter.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_perimeter.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_perimeter.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double euler_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_euler.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_euler.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_euler.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_euler.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_euler.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_euler.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_euler.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_euler.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_euler.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double w102_xx_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xx.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_xx.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xx.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xx.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_xx.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xx.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xx.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_xx.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xx.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double w102_xy_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_xy.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_xy.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_xy.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_xy.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_xy.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_xy.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_xy.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_xy.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_xy.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double w102_yy_pbc(const BinField<bool> &sample)
-{
-  double total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_w102_yy.at(convert(sample.call(X,Ny-1),sample.call(Nx-1,Ny-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-  // Range 8
-  X++;
-  while(X < Nx)
-    {
-      total += rg8_w102_yy.at(convert(sample.call(X,Ny-1),sample.call(X-1,Ny-1),sample.call(X,Y),sample.call(X-1,Y)));
-      X++;
-    }
-
-  // Range 9
-  total += rg9_w102_yy.at(convert(sample.call(0,Ny-1),sample.call(Nx-1,Ny-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < Ny)
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_w102_yy.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,Y),sample.call(Nx-1,Y)));
-
-      // Range 5
-      X++;
-      while(X < Nx)
-        {
-          total += rg5_w102_yy.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,Y),sample.call(X-1,Y)));
-          X++;
-        }
-
-      // Range 6
-      total += rg6_w102_yy.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,Y),sample.call(Nx-1,Y)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_w102_yy.at(convert(sample.call(X,Y-1),sample.call(Nx-1,Y-1),sample.call(X,0),sample.call(Nx-1,0)));
-
-  // Range 2
-  X++;
-  while(X < Nx)
-    {
-      total += rg2_w102_yy.at(convert(sample.call(X,Y-1),sample.call(X-1,Y-1),sample.call(X,0),sample.call(X-1,0)));
-      X++;
-    }
-
-  // Range 3
-  total += rg3_w102_yy.at(convert(sample.call(0,Y-1),sample.call(Nx-1,Y-1),sample.call(0,0),sample.call(Nx-1,0)));
-
-  return total;
-}
-
-double delta_pbc(const BinField<bool> &sample)
-{
-  double w102_xx_ = w102_xx_pbc(sample);
-  double w102_xy_ = w102_xy_pbc(sample);
-  double w102_yy_ = w102_yy_pbc(sample);
-
-  return sqrt((w102_xx_-w102_yy_)*(w102_xx_-w102_yy_)+4*w102_xy_*w102_xy_);
-}
-
-// Look-up table but pixelized data: all functional values times 8:
-int area_mbc_pix(const BinField<bool> &sample)
-{
-  int total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-
-      Y++;
-    }
-
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  X = 0;
-  total += rg1_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  return total;
-}
-
-int perimeter_mbc_pix(const BinField<bool> &sample)
-{
-  int total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
-
-  // Range 7
-  X = 0;
-  total += rg7_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
+  check_subfield(sample, xi, yi, Nx, Ny);
 
-      // Range 4
-      X = 0;
-      total += rg4_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  unsigned ix = xi;
+  unsigned iy = yi;
+  for(iy = yi+1; iy < (yi+Ny-1); iy++)
+    total += ( (sample.call(ix,iy)==false) && sample.call(ix+1,iy) );
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  ix = xi+Nx-2;
+  for(iy = yi+1; iy < (yi+Ny-1); iy++)
+    total += ( (sample.call(ix+1,iy)==false) && sample.call(ix,iy) );
 
-          X++;
-        }
+  for(ix = xi+1; ix < (xi+Nx-2); ix++)
+    for(iy = yi+1; iy < (yi+Ny-1); iy++)
+      total += ( (sample.call(ix+1,iy)==false) && sample.call(ix,iy) ) + ( (sample.call(ix,iy)==false) && sample.call(ix+1,iy) );
 
-      // Range 6
-      total += rg6_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  iy = yi;
+  for(ix = xi+1; ix < (xi+Nx-1); ix++)
+    total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy+1) );
 
+  iy = yi+Ny-2;
+  for(ix = xi+1; ix < (xi+Nx-1); ix++)
+    total += ( (sample.call(ix,iy+1)==false) && sample.call(ix,iy) );
 
-      Y++;
-    }
+  for(iy = yi+1; iy < (yi+Ny-2); iy++)
+    for(ix = xi+1; ix < (xi+Nx-1); ix++)
+    total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy+1) ) + ( (sample.call(ix,iy+1)==false) && sample.call(ix,iy) );
 
-  // -----------------------
-  // TOP ROW
+  return total;
+}
 
-  // Range 1
-  X = 0;
-  total += rg1_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+double euler_pixelized_mbc(const BinField<bool> &sample,
+                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  return euler_mbc(sample, xi, yi, Nx, Ny);
+}
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+// Periodic boundary condition
+double area_pixelized_pbc(const BinField<bool> &sample,
+                          const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  double total = 0;
 
-      X++;
-    }
+  check_subfield(sample, xi, yi, Nx, Ny);
 
-  // Range 3
-  total += rg3_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  for(unsigned ix = xi; ix < (xi+Nx); ix++)
+    for(unsigned iy = yi; iy < (yi+Ny); iy++)
+      total += sample.call(ix,iy);
 
   return total;
 }
 
-int euler_mbc_pix(const BinField<bool> &sample)
+double perimeter_pixelized_pbc(const BinField<bool> &sample,
+                               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
 {
-  int total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-
-  // -----------------------
-  // BOTTOM ROW
-  Y = 0;
+  double total = 0;
 
-  // Range 7
-  X = 0;
-  total += rg7_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  check_subfield(sample, xi, yi, Nx, Ny);
 
-  // Range 8
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg8_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  unsigned ix = xi;
+  unsigned iy = yi;
+  for(iy = yi; iy < yi+Ny; iy++){
+    total += ( (sample.call(Nx-1,iy)==false) && sample.call(0,iy) );
+    total += ( (sample.call(0,iy)==false) && sample.call(Nx-1,iy) );
+  }
 
-      X++;
+  for(ix = xi+1; ix < xi+Nx; ix++)
+    for(iy = yi; iy < yi+Ny; iy++){
+      total += ( (sample.call(ix-1,iy)==false) && sample.call(ix,iy) );
+      total += ( (sample.call(ix,iy)==false) && sample.call(ix-1,iy) );
     }
 
-  // Range 9
-  total += rg9_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-  // -----------------------
-  // MID ROWS
-  Y++;
-  while(Y < (Ny-2))
-    {
-
-      // Range 4
-      X = 0;
-      total += rg4_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  for(ix = xi; ix < xi+Nx; ix++){
+    total += ( (sample.call(ix,Ny-1)==false) && sample.call(ix,0) );
+    total += ( (sample.call(ix,0)==false) && sample.call(ix,Ny-1) );
+  }
 
-      // Range 5
-      X++;
-      while(X < (Nx-2))
-        {
-          total += rg5_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  for(iy = yi+1; iy < yi+Ny; iy++)
+    for(ix = xi; ix < xi+Nx; ix++){
+      total += ( (sample.call(ix,iy)==false) && sample.call(ix,iy-1) );
+      total += ( (sample.call(ix,iy-1)==false) && sample.call(ix,iy) );
+    }
 
-          X++;
-        }
+  return total;
+}
 
-      // Range 6
-      total += rg6_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+double euler_pixelized_pbc(const BinField<bool> &sample,
+                           const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny)
+{
+  return euler_pbc(sample, xi, yi, Nx, Ny);
+}
 
+// PAPAYA
+void print_pgm(const BinField<bool> &sample,
+               const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+               const std::string &filename, const std::string &prefix_of, const bool &invert)
+{
 
-      Y++;
-    }
+  check_subfield(sample, xi, yi, Nx, Ny);
 
-  // -----------------------
-  // TOP ROW
+  std::ofstream OutFile( (prefix_of + filename).c_str() );
+  OutFile << "P2" << std::endl;
+  OutFile << Nx << " " << Ny << std::endl;
+  OutFile << "255" << std::endl;
 
-  // Range 1
-  X = 0;
-  total += rg1_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  unsigned truephase = 255, voidphase = 0;
+  if(invert){
+    truephase = 0; voidphase = 255;}
 
-  // Range 2
-  X++;
-  while(X < (Nx-2))
-    {
-      total += rg2_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+  for(unsigned j = (Ny-1); j < Ny; j--)
+    for(unsigned i = 0; i < Nx; i++)
+      {
+        if( sample.call(i,j) )
+          OutFile << truephase << std::endl;
+        else
+          OutFile << voidphase << std::endl;
+      }
 
-      X++;
-    }
+  OutFile.close();
+}
 
-  // Range 3
-  total += rg3_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+// ---------------------------------------------------------------
+// Only BinField as argument:
 
-  return total;
+// Minus sampling boundary condition
+double area_mbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, double, area_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
 }
 
-// White boundary condition
-int area_wbc_pix(const BinField<bool> &sample)
+double perimeter_mbc(const BinField<bool> &sample)
 {
-  int total = 0;
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
-  unsigned X;
-  unsigned Y;
-
-  // -----------------------
-  // BOTTOM ROW
+  return SumOfWindows<MinusSamplingBC, double, perimeter_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // Range 7
-  total += rg7_area_pix.at(convert(false,false,sample.call(0,0),false));
+double euler_mbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, double, euler_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // Range 8
-  X=0;
-  while(X < (Nx-1))
-    {
-      total += rg8_area_pix.at(convert(false,false,sample.call(X+1,0),sample.call(X,0)));
+double w102_xx_mbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, double, w102_xx_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-      X++;
-    }
+double w102_xy_mbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, double, w102_xy_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // Range 9
-  total += rg9_area_pix.at(convert(false,false,false,sample.call(Nx-1,0)));
+double w102_yy_mbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, double, w102_yy_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // -----------------------
-  // MID ROWS
-  Y=0;
-  while(Y < (Ny-1))
-    {
+double delta_mbc(const BinField<bool> &sample)
+{
+  // the tensor components from a single traversal
+  return minkowski_mbc(sample).delta;
+}
 
-      // Range 4
-      total += rg4_area_pix.at(convert(sample.call(0,Y),false,sample.call(0,Y+1),false));
+// Periodic boundary condition
+double area_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, area_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-      // Range 5
-      X=0;
-      while(X < (Nx-1))
-        {
-          total += rg5_area_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+double perimeter_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, perimeter_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-          X++;
-        }
+double euler_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, euler_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-      // Range 6
-      total += rg6_area_pix.at(convert(false,sample.call(Nx-1,Y),false,sample.call(Nx-1,Y+1)));
+double w102_xx_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, w102_xx_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-      Y++;
-    }
+double w102_xy_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, w102_xy_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // -----------------------
-  // TOP ROW
+double w102_yy_pbc(const BinField<bool> &sample)
+{
+  return SumOfWindows<PeriodicBC, double, w102_yy_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // Range 1
-  total += rg1_area_pix.at(convert(sample.call(0,Ny-1),false,false,false));
+double delta_pbc(const BinField<bool> &sample)
+{
+  // the tensor components from a single traversal
+  return minkowski_pbc(sample).delta;
+}
 
-  // Range 2
-  X=0;
-  while(X < (Nx-1))
-    {
-      total += rg2_area_pix.at(convert(sample.call(X+1,Ny-1),sample.call(X,Ny-1),false,false));
+// Look-up table but pixelized data: all functional values times 8:
+int area_mbc_pix(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, int, area_pix_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-      X++;
-    }
+int perimeter_mbc_pix(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, int, perimeter_pix_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  // Range 3
-  total += rg3_area_pix.at(convert(false,sample.call(Nx-1,Ny-1),false,false));
+int euler_mbc_pix(const BinField<bool> &sample)
+{
+  return SumOfWindows<MinusSamplingBC, int, euler_pix_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
 
-  return total;
+// White boundary condition
+int area_wbc_pix(const BinField<bool> &sample)
+{
+  return SumOfWindows<WhiteBC, int, area_pix_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
 }
 
 int perimeter_wbc_pix(const BinField<bool> &sample)
+{
+  return SumOfWindows<WhiteBC, int, perimeter_pix_tables>(sample, 0, 0, sample.call_Nx(), sample.call_Ny());
+}
+
+int euler_wbc_pix(const BinField<bool> &sample)
 {
   int total = 0;
-  unsigned Nx = sample.call_Nx();
+  unsigned Nw = sample.call_Nw();
   unsigned Ny = sample.call_Ny();
 
-  unsigned X;
-  unsigned Y;
+  // white boundary condition: the rows below and above the sample are false
+  std::vector<uint64_t> white(Nw,0);
 
   // -----------------------
   // BOTTOM ROW
-
-  // Range 7
-  total += rg7_perimeter_pix.at(convert(false,false,sample.call(0,0),false));
-
-  // Range 8
-  X=0;
-  while(X < (Nx-1))
-    {
-      total += rg8_perimeter_pix.at(convert(false,false,sample.call(X+1,0),sample.call(X,0)));
-
-      X++;
-    }
-
-  // Range 9
-  total += rg9_perimeter_pix.at(convert(false,false,false,sample.call(Nx-1,0)));
+  total += euler_wbc_pix_rows(&white[0],sample.row(0),Nw);
 
   // -----------------------
   // MID ROWS
-  Y=0;
-  while(Y < (Ny-1))
-    {
-
-      // Range 4
-      total += rg4_perimeter_pix.at(convert(sample.call(0,Y),false,sample.call(0,Y+1),false));
-
-      // Range 5
-      X=0;
-      while(X < (Nx-1))
-        {
-          total += rg5_perimeter_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
-
-          X++;
-        }
-
-      // Range 6
-      total += rg6_perimeter_pix.at(convert(false,sample.call(Nx-1,Y),false,sample.call(Nx-1,Y+1)));
-
-      Y++;
-    }
+  for(unsigned Y = 0; Y < (Ny-1); Y++)
+    total += euler_wbc_pix_rows(sample.row(Y),sample.row(Y+1),Nw);
 
   // -----------------------
   // TOP ROW
-
-  // Range 1
-  total += rg1_perimeter_pix.at(convert(sample.call(0,Ny-1),false,false,false));
-
-  // Range 2
-  X=0;
-  while(X < (Nx-1))
-    {
-      total += rg2_perimeter_pix.at(convert(sample.call(X+1,Ny-1),sample.call(X,Ny-1),false,false));
-
-      X++;
-    }
-
-  // Range 3
-  total += rg3_perimeter_pix.at(convert(false,sample.call(Nx-1,Ny-1),false,false));
+  total += euler_wbc_pix_rows(sample.row(Ny-1),&white[0],Nw);
 
   return total;
 }
 
-int euler_wbc_pix(const BinField<bool> &sample)
+int euler_wbc_pix(const BinField<bool> &sample, const bool &complement)
 {
+  if(!complement)
+    return euler_wbc_pix(sample);
+
   int total = 0;
-  unsigned Nx = sample.call_Nx();
+  unsigned Nw = sample.call_Nw();
   unsigned Ny = sample.call_Ny();
+  // padding bits beyond Nx stay false
+  const uint64_t last_word = (sample.call_Nx() % 64) ? (uint64_t(1) << (sample.call_Nx() % 64)) - 1 : ~uint64_t(0);
 
-  unsigned X;
-  unsigned Y;
-
-  // -----------------------
-  // BOTTOM ROW
-
-  // Range 7
-  total += rg7_euler_pix.at(convert(false,false,sample.call(0,0),false));
+  // the white rows below and above the complement, and the previous and current inverted row
+  std::vector<uint64_t> white(Nw,0);
+  std::vector<uint64_t> low(Nw,0);
+  std::vector<uint64_t> up(Nw);
 
-  // Range 8
-  X=0;
-  while(X < (Nx-1))
+  for(unsigned Y = 0; Y < Ny; Y++)
     {
-      total += rg8_euler_pix.at(convert(false,false,sample.call(X+1,0),sample.call(X,0)));
+      const uint64_t *row = sample.row(Y);
+      for(unsigned wi = 0; wi < Nw; wi++)
+        up[wi] = ~row[wi];
+      up[Nw-1] &= last_word;
 
-      X++;
+      total += euler_wbc_pix_rows(&low[0],&up[0],Nw);
+      low.swap(up);
     }
+  total += euler_wbc_pix_rows(&low[0],&white[0],Nw);
 
-  // Range 9
-  total += rg9_euler_pix.at(convert(false,false,false,sample.call(Nx-1,0)));
-
-  // -----------------------
-  // MID ROWS
-  Y=0;
-  while(Y < (Ny-1))
-    {
-
-      // Range 4
-      total += rg4_euler_pix.at(convert(sample.call(0,Y),false,sample.call(0,Y+1),false));
+  return total;
+}
 
-      // Range 5
-      X=0;
-      while(X < (Nx-1))
-        {
-          total += rg5_euler_pix.at(convert(sample.call(X+1,Y),sample.call(X,Y),sample.call(X+1,Y+1),sample.call(X,Y+1)));
+// Word-parallel Euler characteristic (times 8) of the 2x2 windows between two bit-packed rows
+//
+// For the union of closed pixels (eight-fold connected as in rg5_euler_pix) chi = vertices - edges + faces.
+// Per pair of rows, the vertices between the rows minus the horizontal edges between them is the number
+// of runs of true pixels in (low | up); the vertical edges minus the faces of the row low is the number of
+// runs in low. Summed over all pairs of rows (including the white rows outside) this is the same value
+// as the sum of rg*_euler_pix over all windows.
+int euler_wbc_pix_rows(const uint64_t *low, const uint64_t *up, const unsigned &Nw)
+{
+  int total = 0;
+  uint64_t carry_both = 0;
+  uint64_t carry_low = 0;
 
-          X++;
-        }
+  for(unsigned wi = 0; wi < Nw; wi++)
+    {
+      const uint64_t both = low[wi] | up[wi];
 
-      // Range 6
-      total += rg6_euler_pix.at(convert(false,sample.call(Nx-1,Y),false,sample.call(Nx-1,Y+1)));
+      // a run starts at every true pixel whose left neighbor is false
+      total += popcount( both & ~((both << 1) | carry_both) );
+      total -= popcount( low[wi] & ~((low[wi] << 1) | carry_low) );
 
-      Y++;
+      carry_both = both >> 63;
+      carry_low = low[wi] >> 63;
     }
 
-  // -----------------------
-  // TOP ROW
-
-  // Range 1
-  total += rg1_euler_pix.at(convert(sample.call(0,Ny-1),false,false,false));
-
-  // Range 2
-  X=0;
-  while(X < (Nx-1))
-    {
-      total += rg2_euler_pix.at(convert(sample.call(X+1,Ny-1),sample.call(X,Ny-1),false,false));
+  return 8*total;
+}
 
-      X++;
-    }
+EulerWbcPixRows::EulerWbcPixRows(const unsigned &Nw) :
+previous_ ( std::vector<uint64_t> (Nw,0) ), white_ ( std::vector<uint64_t> (Nw,0) ), total_ ( 0 )
+{}
 
-  // Range 3
-  total += rg3_euler_pix.at(convert(false,sample.call(Nx-1,Ny-1),false,false));
+void EulerWbcPixRows::add_row(const uint64_t *row)
+{
+  // white boundary condition: previous_ is white before the bottom row
+  total_ += euler_wbc_pix_rows(&previous_[0], row, previous_.size());
+  std::copy(row, row + previous_.size(), previous_.begin());
+}
 
-  return total;
+int EulerWbcPixRows::euler() const
+{
+  return total_ + euler_wbc_pix_rows(&previous_[0], &white_[0], previous_.size());
 }
 
 // PIXELIZED DATA
@@ -81,6 +81,131 @@ double delta_pbc(const BinField<bool> &sample);
 double delta_pbc(const BinField<bool> &sample,
                  const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny);
 
+// Single traversal for all functionals: the 16-bin histograms of the configurations (see convert)
+// of the 2x2 windows per range 1...9 of the look-up tables (counts[0] is empty), from which every
+// functional is the dot product with its tables
+//
+// With N_threads > 1 (0 = all cores) the sample is split into horizontal bands that are counted
+// concurrently. The counts are integers, so that the histograms, and the functionals computed from
+// them, are the same for any N_threads (bit for bit).
+//
+// The windows inside of a row are counted with the widest vector instructions the CPU supports.
+struct WindowHistogram {
+  long counts[10][16];
+};
+
+// Instruction set of the row kernel of the histograms, as chosen at runtime:
+// "avx512", "avx2", "sse2", or "scalar"
+std::string histogram_kernel();
+// Instruction sets that the CPU supports, from the widest one (the default) to "scalar"
+std::vector<std::string> histogram_kernels();
+// Use the kernel of another supported instruction set (e.g., to check the kernels against each other);
+// returns false if the CPU does not support it. Must not be called while histograms are computed.
+bool set_histogram_kernel(const std::string &name);
+
+void histogram_mbc(const BinField<bool> &sample, WindowHistogram &histogram, const unsigned &N_threads = 1);
+void histogram_mbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                   WindowHistogram &histogram);
+
+void histogram_pbc(const BinField<bool> &sample, WindowHistogram &histogram, const unsigned &N_threads = 1);
+void histogram_pbc(const BinField<bool> &sample,
+                   const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny,
+                   WindowHistogram &histogram);
+
+// Functional of a histogram, e.g., area with area_tables or area (times 8) of pixelized data with area_pix_tables
+template < typename number >
+number functional(const WindowHistogram &histogram, const RangeTables<number> &tables)
+{
+  number total = 0;
+  for(unsigned range = 1; range < 10; range++)
+    for(unsigned conf = 0; conf < 16; conf++)
+      total += histogram.counts[range][conf] * tables[range][conf];
+  return total;
+}
+
+// All functionals and tensors with the same boundary condition (up to the rounding of the sums
+// the values of area_mbc, ..., delta_mbc, or of area_pbc, ..., delta_pbc)
+struct MinkowskiValues {
+  double area;
+  double perimeter;
+  double euler;
+  double w102_xx;
+  double w102_xy;
+  double w102_yy;
+  double delta;
+};
+
+MinkowskiValues minkowski_values(const WindowHistogram &histogram);
+
+MinkowskiValues minkowski_mbc(const BinField<bool> &sample, const unsigned &N_threads = 1);
+MinkowskiValues minkowski_mbc(const BinField<bool> &sample,
+                              const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny);
+
+MinkowskiValues minkowski_pbc(const BinField<bool> &sample, const unsigned &N_threads = 1);
+MinkowskiValues minkowski_pbc(const BinField<bool> &sample,
+                              const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny);
+
+// Sky map of a functional with minus sampling boundary condition: its value for every
+// Nx x Ny SubBinField of a sample, e.g., euler_mbc(sample, xi, yi, Nx, Ny) with euler_tables
+//
+// The configurations of all windows of the sample are determined once, and the tables of
+// the bulk (range 5) are summed into a two-dimensional prefix sum, those of the bottom and
+// top row (ranges 8 and 2) into prefix sums along each row, and those of the left and right
+// column (ranges 4 and 6) into prefix sums along each column. A SubBinField is then the
+// difference of four bulk sums, plus two differences per side and the four corners,
+// independent of its size; a whole sky map costs O(Nx*Ny) of the sample instead of
+// O(Nx*Ny*w^2) for windows of w x w pixels. The memory is about five doubles per pixel.
+// Up to the rounding of the sums the values are those of the direct sums (the values of
+// euler_tables are exact in double).
+class MinkowskiSkyMap {
+
+ public:
+  MinkowskiSkyMap(const BinField<bool> &sample, const RangeTables<double> &tables);
+
+  // Value of the Nx x Ny SubBinField at (xi,yi) (with Nx, Ny > 2)
+  double value(const unsigned &xi, const unsigned &yi, const unsigned &Nx, const unsigned &Ny) const;
+
+  // Values of all Nx x Ny SubBinFields, where sky_map(xi,yi) is the value of the one at (xi,yi)
+  // (sky_map has to be a (sample.Nx-Nx+1) x (sample.Ny-Ny+1) BinField)
+  void map(const unsigned &Nx, const unsigned &Ny, BinField<double> &sky_map) const;
+
+ private:
+  RangeTables<double> tables_;
+  // windows (X,Y) with lower left pixel (X,Y), for X < NX_ and Y < NY_
+  unsigned NX_, NY_;
+  std::vector<unsigned char> conf_;
+  // bulk_[Y*(NX_+1)+X]: sum of range 5 over the windows below Y and left of X
+  std::vector<double> bulk_;
+  // bottom_[Y*(NX_+1)+X], top_: sum of range 8 (or 2) over the windows of row Y left of X
+  std::vector<double> bottom_, top_;
+  // left_[X*(NY_+1)+Y], right_: sum of range 4 (or 6) over the windows of column X below Y
+  std::vector<double> left_, right_;
+};
+
+// Sky map of delta_mbc from the sky maps of the three components of the tensor
+void delta_mbc_sky_map(const BinField<bool> &sample, const unsigned &Nx, const unsigned &Ny,
+                       BinField<double> &sky_map);
+
+// Threshold sweep of a grayscale field: the window histograms of the excursion sets
+//   sample_k(xi,yi) = ( field(xi,yi) >= thresholds[k] ),   k = 0...thresholds.size()-1,
+// for ascending thresholds, without thresholded copies of the field
+//
+// Each pixel is assigned the number of thresholds below or at its value (by bisection), so that it
+// is true in the samples before this index. The four pixels of a window thus drop out one after the
+// other as the threshold increases, and the window only adds its changes of configuration at these
+// (at most four) indices. A prefix sum over the thresholds then yields all histograms, i.e., the cost
+// is O(Nx*Ny*log(T) + T) instead of O(T*Nx*Ny) for T thresholds. The histograms are those of
+// histogram_mbc(sample_k) (or histogram_pbc(sample_k)).
+void threshold_histograms_mbc(const BinField<double> &field, const std::vector<double> &thresholds,
+                              std::vector<WindowHistogram> &histograms);
+void threshold_histograms_pbc(const BinField<double> &field, const std::vector<double> &thresholds,
+                              std::vector<WindowHistogram> &histograms);
+
+// Functionals and tensors of the excursion sets as a function of the threshold
+std::vector<MinkowskiValues> minkowski_thresholds_mbc(const BinField<double> &field, const std::vector<double> &thresholds);
+std::vector<MinkowskiValues> minkowski_thresholds_pbc(const BinField<double> &field, const std::vector<double> &thresholds);
+
 // Look-up table but pixelized data: all functional values times 8:
 int area_mbc_pix(const BinField<bool> &sample);
 
@@ -93,6 +218,36 @@ int area_wbc_pix(const BinField<bool> &sample);
 int perimeter_wbc_pix(const BinField<bool> &sample);
 
 int euler_wbc_pix(const BinField<bool> &sample);
+// euler_wbc_pix of the sample, or if complement of its complement (as after BinField<bool>::invert()),
+// where each pair of rows is inverted on the fly instead of the whole sample
+int euler_wbc_pix(const BinField<bool> &sample, const bool &complement);
+// Word-parallel kernel of euler_wbc_pix for the windows between two adjacent bit-packed rows (Nw words each)
+int euler_wbc_pix_rows(const uint64_t *low, const uint64_t *up, const unsigned &Nw);
+
+// Two-row accumulator of euler_wbc_pix for a sample that is streamed row by row,
+// from the bottom row (yi = 0) to the top row; only the previous row is kept
+class EulerWbcPixRows {
+
+ public:
+  // Rows of Nw words each
+  EulerWbcPixRows(const unsigned &Nw);
+
+  void add_row(const uint64_t *row);
+  // euler_wbc_pix of the rows added so far (closed by a white row above the last one)
+  int euler() const;
+
+ private:
+  std::vector<uint64_t> previous_;
+  std::vector<uint64_t> white_;
+  int total_;
+};
+
+// Functionals (times 8) as computed by area_wbc_pix, perimeter_wbc_pix, and euler_wbc_pix
+struct MinkowskiValuesPix {
+  long area;
+  long perimeter;
+  long euler;
+};
 
 // PIXELIZED DATA
 // Minus sampling boundary condition
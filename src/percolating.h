@@ -0,0 +1,365 @@
+/*
+ * percolating.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: mklatt
+ */
+
+#ifndef PERCOLATING_H_
+#define PERCOLATING_H_
+
+#include "init.h"
+#include "minkowski.h"
+#include "fractal.h"
+#include "cluster.h"
+#include "ensemble.h"
+
+// -------------------------
+// Percolating-cluster executables, templated on the connectivity of the surviving pixels
+// (NearestNeighbors or NextToNearestNeighbors, see cluster.h)
+// -------------------------
+
+static std::string config_file = "FractalPercolationMink.conf";
+static std::string prefix_of = "output/";
+static double p = 0.5;
+static std::vector<double> p_list;
+static unsigned subdivision = 3;
+static unsigned n_approximations = 3;
+static bool all_levels = false;
+static bool cluster_sizes = false;
+static unsigned N_runs = 100;
+static unsigned first_run = 0;
+static bool imageout = false;
+static unsigned seed = 17;
+static unsigned N_threads = 1;
+// Threads of the cluster labeling of a stored approximation: a single run (e.g., a large
+// printed sample) gets all threads, whereas an ensemble runs one labeling per worker
+static unsigned N_labeling_threads = 1;
+
+// Below this expected fraction of surviving pixels (p^n_approximations), percolation is decided
+// along the subdivision tree (see FractalPercolationPercolatingCluster), whose work is
+// proportional to the surviving cells, instead of labeling the streamed rows
+// (unless the cluster sizes are recorded, which the tree walk does not provide)
+static const double max_surviving_fraction_along_tree = 1./64;
+static bool percolation_along_tree = false;
+
+// Observables per recorded level: whether the surviving cells percolate, followed by the area,
+// perimeter, and Euler characteristic of the percolating cluster, of the largest cluster, and of all clusters,
+// and if cluster_sizes, by the moments and the histogram of the cluster sizes (see record_clusters)
+static const unsigned N_functional_observables = 10;
+static unsigned N_size_bins = 0;
+static unsigned N_observables_per_level = N_functional_observables;
+
+// One worker of the ensemble of simulation runs, which owns its approximations;
+// the random numbers of a run are keyed by (seed, run)
+template < typename connectivity >
+class Simulation {
+
+ public:
+  Simulation();
+
+  // observables[N_observables_per_level*li + oi] of the li-th recorded level (see record_clusters)
+  void run(const unsigned &run, std::vector<double> &observables);
+
+ private:
+  // all levels 0...n_approximations if all_levels, else only the final approximation
+  // for the printed sample (the other runs stream the final approximation row by row)
+  std::vector< BinField<bool> > approximations_;
+  // sizes of the clusters of the current level (if cluster_sizes)
+  ClusterSizeDistribution sizes_;
+};
+
+// Recorded levels of approximation
+static unsigned level(const unsigned &li);
+
+// functionals of the surviving clusters of approximation, whose rows are labeled run by run,
+// and the sizes of the clusters that do not percolate (unless sizes = 0)
+template < typename connectivity >
+static void evaluate_clusters(const BinField<bool> &approximation, SurvivingClusterFunctionals &clusters,
+                              ClusterSizeDistribution *sizes);
+
+// observables of the li-th recorded level (with first_oi = N_observables_per_level*li):
+// observables[first_oi]                 = 1 if the surviving cells percolate, else 0
+// observables[first_oi + 1 + 3*ci + fi] = functional fi (area, perimeter, Euler characteristic)
+//                                         of the percolating (ci = 0, zero if there is none),
+//                                         the largest (ci = 1), and all clusters (ci = 2)
+// if cluster_sizes, the clusters that do not percolate:
+// observables[first_oi + 10...13]       = number of clusters, sum s, sum s^2, sum s^2 R^2 (see ClusterSizeDistribution)
+// observables[first_oi + 14 + bi]       = number of clusters of sizes 2^bi...2^(bi+1)-1
+static void record_clusters(const SurvivingClusterFunctionals &clusters, const ClusterSizeDistribution &sizes,
+                            const unsigned &li, std::vector<double> &observables);
+
+// input is a black-and-white binfield
+// print it with the surviving cluster that spans the system both horizontally and vertically in black
+template < typename connectivity >
+static void print_percolating_cluster(const BinField<bool> &bw);
+
+// Body of the executables FractalPercolationMink_NN_percolating_cluster and _NNN_percolating_cluster
+template < typename connectivity >
+int PercolatingClusterMain(int clc, char* clv[]){
+  // Read in parameters
+  initialize(clc, clv, config_file, prefix_of, p, p_list, subdivision, n_approximations, all_levels, cluster_sizes, N_runs, first_run, imageout, seed, N_threads);
+  if(!p_list.empty()){
+    std::cerr << "ERROR: a sweep over p_list is only available for all clusters (FractalPercolationMink_NN and _NNN);" << std::endl;
+    exit(-1);
+  }
+  // update_seed
+  seed *= int(p*100+1e-10);
+  seed *= 1000;
+  seed += subdivision*100;
+  seed += n_approximations;
+  // the run index is the second half of the key of the CounterRNG, so that
+  // run r is the same realization for any N_runs, first_run, or number of threads
+
+  if(N_runs == 1)
+    N_labeling_threads = N_threads;
+  percolation_along_tree = !cluster_sizes && pow(p,n_approximations) < max_surviving_fraction_along_tree;
+  if(cluster_sizes){
+    N_size_bins = ClusterSizeDistribution(pow(subdivision,2*n_approximations)).call_N_bins();
+    N_observables_per_level = N_functional_observables + 4 + N_size_bins;
+  }
+
+  unsigned N_levels = all_levels ? n_approximations : 1;
+  EnsembleSums sums = RunEnsemble< Simulation<connectivity> >(N_observables_per_level*N_levels, first_run, N_runs, N_threads);
+
+  for(unsigned li = 0; li < N_levels; li++){
+    unsigned k = level(li);
+    unsigned first_oi = N_observables_per_level*li;
+    double mean_actual_chi = sums.mean(first_oi+3);
+    double std_error_actual_chi = sums.std_error(first_oi+3);
+    double fraction_of_percolating_samples = sums.mean(first_oi);
+
+    std::stringstream outputstst;
+    outputstst << prefix_of << "frac-perc-mink-val-" << connectivity::name << "-percolatingcluster-" << subdivision << "x" << subdivision << "-n-" << k << "-p-" << std::setprecision(2) << p << ".dat";
+    std::ofstream output(outputstst.str().c_str());
+    output << p << " " << mean_actual_chi*pow(1./pow(subdivision,2)/p,k) << " " << std_error_actual_chi*pow(1./pow(subdivision,2)/p,k) << " " << k << " " << fraction_of_percolating_samples << " " << N_runs << std::endl;
+    output.close();
+
+    // area, perimeter, and Euler characteristic of the percolating, the largest, and all clusters
+    std::stringstream clustersstst;
+    clustersstst << prefix_of << "frac-perc-mink-val-" << connectivity::name << "-clusters-" << subdivision << "x" << subdivision << "-n-" << k << "-p-" << std::setprecision(2) << p << ".dat";
+    std::ofstream clusters(clustersstst.str().c_str());
+    clusters << p;
+    for(unsigned oi = first_oi+1; oi < first_oi+N_functional_observables; oi++)
+      clusters << " " << sums.mean(oi)*pow(1./pow(subdivision,2)/p,k) << " " << sums.std_error(oi)*pow(1./pow(subdivision,2)/p,k);
+    clusters << " " << k << " " << N_runs << std::endl;
+    clusters.close();
+
+    if(!cluster_sizes)
+      continue;
+    // the clusters that do not percolate: moments of the sizes, mean cluster size, and correlation length
+    const unsigned first_size_oi = first_oi + N_functional_observables;
+    std::stringstream momentsstst;
+    momentsstst << prefix_of << "frac-perc-mink-val-" << connectivity::name << "-clustermoments-" << subdivision << "x" << subdivision << "-n-" << k << "-p-" << std::setprecision(2) << p << ".dat";
+    std::ofstream moments(momentsstst.str().c_str());
+    moments << p;
+    for(unsigned oi = first_size_oi; oi < first_size_oi+4; oi++)
+      moments << " " << sums.mean(oi) << " " << sums.std_error(oi);
+    double mean_cluster_size = sums.mean(first_size_oi+1) > 0 ? sums.mean(first_size_oi+2)/sums.mean(first_size_oi+1) : 0;
+    double correlation_length = sums.mean(first_size_oi+2) > 0 ? sqrt(2*sums.mean(first_size_oi+3)/sums.mean(first_size_oi+2)) : 0;
+    moments << " " << mean_cluster_size << " " << correlation_length << " " << k << " " << N_runs << std::endl;
+    moments.close();
+
+    // log-binned histogram: mean number of clusters of sizes 2^bi...2^(bi+1)-1 per sample
+    std::stringstream sizesstst;
+    sizesstst << prefix_of << "frac-perc-mink-val-" << connectivity::name << "-clustersizes-" << subdivision << "x" << subdivision << "-n-" << k << "-p-" << std::setprecision(2) << p << ".dat";
+    std::ofstream sizes(sizesstst.str().c_str());
+    for(unsigned bi = 0; bi < N_size_bins; bi++)
+      sizes << (1ul << bi) << " " << (2ul << bi)-1 << " " << sums.mean(first_size_oi+4+bi) << " " << sums.std_error(first_size_oi+4+bi) << std::endl;
+    sizes.close();
+  }
+
+  return 0;
+}
+
+
+template < typename connectivity >
+Simulation<connectivity>::Simulation() :
+sizes_ ( ClusterSizeDistribution(pow(subdivision,2*n_approximations)) )
+{
+  if(all_levels || imageout)
+    for(unsigned k = all_levels ? 0 : n_approximations; k <= n_approximations; k++)
+      approximations_.push_back(BinField<bool>(pow(subdivision,k), false));
+}
+
+template < typename connectivity >
+void Simulation<connectivity>::run(const unsigned &run, std::vector<double> &observables)
+{
+  // black = true = death
+  // white = false = no death = survival
+  double p_turning_black = 1 - p;
+
+  CounterRNG rng(seed, run);
+
+  // only the last run prints its sample, which the serial loop used to leave behind
+  bool print_sample = imageout && run == first_run+N_runs-1;
+  SurvivingClusterFunctionals clusters;
+
+  if(all_levels){
+    // refine one realization level by level, starting from the surviving unit square;
+    // the final approximation is the same realization as drawn by the tree walk below
+    for(unsigned k = 1; k <= n_approximations; k++){
+      RefineFractalPercolationBinField(approximations_[k-1], approximations_[k], subdivision, k, p_turning_black, rng);
+      evaluate_clusters<connectivity>(approximations_[k], clusters, cluster_sizes ? &sizes_ : 0);
+      record_clusters(clusters, sizes_, k-1, observables);
+    }
+    if(print_sample)
+      print_percolating_cluster<connectivity>(approximations_.back());
+  }
+  else if(print_sample){
+    // linear size of approximation
+    int final_Mx = pow(subdivision,n_approximations);
+
+    BinField<bool> &final_approximation = approximations_.back();
+    final_approximation.assign_block(0, final_Mx-1, 0, final_Mx-1, false);
+
+    // in the k-th approximation a dying square kills all its offsprings
+    // in final_approximation; only children of surviving cells are drawn
+    RandomFractalPercolationBinField(final_approximation, subdivision, n_approximations, p_turning_black, rng);
+
+    evaluate_clusters<connectivity>(final_approximation, clusters, cluster_sizes ? &sizes_ : 0);
+    record_clusters(clusters, sizes_, 0, observables);
+    print_percolating_cluster<connectivity>(final_approximation);
+  }
+  else if(percolation_along_tree){
+    // only the sides of the surviving cells along the current path of the tree are stored
+    FractalPercolationPercolatingCluster<connectivity>(subdivision, n_approximations, p_turning_black, rng, clusters);
+    record_clusters(clusters, sizes_, 0, observables);
+  }
+  else{
+    // the rows of the final approximation are drawn one after the other and labeled on the fly,
+    // so that only O(subdivision^n_approximations) pixels and labels are stored
+    FractalPercolationRows rows(subdivision, n_approximations, p_turning_black, rng);
+    PercolatingClusterRows<connectivity> labeling(rows.call_Nx(), rows.call_Nx());
+    sizes_.clear();
+    if(cluster_sizes)
+      labeling.record_sizes(&sizes_);
+    for(unsigned yi = 0; yi < rows.call_Nx(); yi++)
+      labeling.add_row(rows.row(yi));
+
+    clusters = labeling.functionals();
+    record_clusters(clusters, sizes_, 0, observables);
+  }
+
+  // one write per message keeps the lines of concurrent runs intact
+  std::stringstream messagestst;
+  if(clusters.percolates)
+    messagestst << "Run " << run << " found  _a_ percolating cluster ...\n";
+  else
+    messagestst << "Run " << run << " found _no_ percolating cluster ...\n";
+  std::cout << messagestst.str();
+}
+
+
+static unsigned level(const unsigned &li)
+{
+  return all_levels ? li+1 : n_approximations;
+}
+
+
+template < typename connectivity >
+static void evaluate_clusters(const BinField<bool> &approximation, SurvivingClusterFunctionals &clusters,
+                              ClusterSizeDistribution *sizes)
+{
+  PercolatingClusterRows<connectivity> labeling(approximation.call_Nx(), approximation.call_Ny());
+  if(sizes){
+    sizes->clear();
+    labeling.record_sizes(sizes);
+  }
+  for(unsigned yi = 0; yi < approximation.call_Ny(); yi++)
+    labeling.add_row(approximation.row(yi));
+  clusters = labeling.functionals();
+}
+
+
+static void record_clusters(const SurvivingClusterFunctionals &clusters, const ClusterSizeDistribution &sizes,
+                            const unsigned &li, std::vector<double> &observables)
+{
+  std::vector<double>::iterator o = observables.begin() + N_observables_per_level*li;
+  *(o++) = clusters.percolates;
+  const MinkowskiValuesPix *functionals[3] = { &clusters.percolating, &clusters.largest, &clusters.all };
+  for(unsigned ci = 0; ci < 3; ci++){
+    *(o++) = functionals[ci]->area/8.;
+    *(o++) = functionals[ci]->perimeter/8.;
+    *(o++) = functionals[ci]->euler/8.;
+  }
+
+  if(!cluster_sizes)
+    return;
+  *(o++) = sizes.N_clusters();
+  *(o++) = sizes.sum_size();
+  *(o++) = sizes.sum_size_squared();
+  *(o++) = sizes.sum_size_squared_radius_squared();
+  for(unsigned bi = 0; bi < N_size_bins; bi++)
+    *(o++) = sizes.histogram(bi);
+}
+
+
+
+// input is a black-and-white binfield
+// print it with the surviving (white) cluster that spans the system both horizontally and vertically in black
+template < typename connectivity >
+static void print_percolating_cluster(const BinField<bool> &bw){
+  // black = true = death
+  // white = false = no death = survival
+
+  // extract
+  unsigned Nx = bw.call_Nx();
+  unsigned Ny = bw.call_Ny();
+
+  // define a BinField of labels (label 0 = "dead/black/true")
+  BinField<int> labels(Nx,Ny,0);
+  int largest_label = LabelSurvivingClusters<connectivity>(bw, labels, N_labeling_threads);
+  // Now all pixels have a label according to their clusters
+
+  // Find for each label the maximum and minimum xi
+  std::vector<int> min_xi_per_label(largest_label,Nx);
+  std::vector<int> max_xi_per_label(largest_label,0);
+  std::vector<int> min_yi_per_label(largest_label,Ny);
+  std::vector<int> max_yi_per_label(largest_label,0);
+
+  for(int xi = 0; xi < int(Nx); xi++)
+    for(int yi = 0; yi < int(Ny); yi++){
+      int current_label = labels.call(xi,yi);
+      if(current_label > 0){
+	int index = current_label - 1;
+  	if(min_xi_per_label[index] > xi)
+  	  min_xi_per_label[index] = xi;
+  	if(max_xi_per_label[index] < xi)
+  	  max_xi_per_label[index] = xi;
+  	if(min_yi_per_label[index] > yi)
+  	  min_yi_per_label[index] = yi;
+  	if(max_yi_per_label[index] < yi)
+  	  max_yi_per_label[index] = yi;
+      }
+    }
+
+  int percolating_label = 0;
+  // Is there a percolating cluster?
+  for(int li = 0; li < largest_label; li++)
+    if (min_xi_per_label[li] == 0 && max_xi_per_label[li] == int(Nx-1) && min_yi_per_label[li] == 0 && max_yi_per_label[li] == int(Ny-1)){
+      percolating_label = li + 1;
+      break; // there can only be one percolating cluster
+    }
+
+  std::stringstream pgmoutstst;
+  pgmoutstst << prefix_of << "frac-perc-mink-val-" << connectivity::name << "-percolatingcluster-" << subdivision << "x" << subdivision << "-n-" << n_approximations << "-p-" << std::setprecision(2) << p << ".pgm";
+  std::ofstream pgmout(pgmoutstst.str().c_str());
+  pgmout << "P2" << std::endl;
+  pgmout << Ny << " " << Nx << std::endl;
+  pgmout << "255" << std::endl; // max value (white)
+
+  for(unsigned yi = Ny-1; yi < Ny; yi--)
+    for(unsigned xi = 0; xi < Nx; xi++){
+      if( bw.call(xi,yi) == false && labels.call(xi,yi) == percolating_label )
+	pgmout << "0" << std::endl; //black (percolating)
+      else if( bw.call(xi,yi) == false )
+	pgmout << "125" << std::endl; //gray (alive)
+      else
+	pgmout << "255" << std::endl; //white (dead)
+    }
+  pgmout.close();
+}
+
+
+#endif /* PERCOLATING_H_ */
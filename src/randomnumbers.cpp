@@ -11,6 +11,26 @@
 // Random Number Generators:
 // -------------------------
 
+// -------------------------
+// Independent generator states (e.g., one per thread)
+gsl_rng* AllocateRNG (const unsigned long &seed)
+{
+  gsl_rng_env_setup();
+
+  gsl_rng * rng = gsl_rng_alloc (gsl_rng_mt19937);
+  // seed = 0 is replaced by default seed
+  gsl_rng_set (rng, seed);
+
+  return rng;
+}
+
+void FreeRNG (gsl_rng *rng)
+{
+  gsl_rng_free (rng);
+}
+// -------------------------
+
+
 // -------------------------
 // Random Number Generator of Poisson Distributed numbers
 unsigned RandomPoisson (const double &mean, const unsigned &seed)
@@ -31,16 +51,17 @@ unsigned RandomPoisson (const double &mean, const unsigned &seed)
     gsl_rng_set (rngPoisson, seed);
   }
 
-  return gsl_ran_poisson (rngPoisson, mean);
+  return RandomPoisson(mean, rngPoisson);
+}
+unsigned RandomPoisson (const double &mean, gsl_rng *rng)
+{
+  return gsl_ran_poisson (rng, mean);
 }
 
 
 // Generator of Random Poisson Bin Fields
 void RandomPoissonBinField (BinField<unsigned> &countrate, const BinField<double> &mean, const unsigned &seed)
 {
-  unsigned Nx = mean.call_Nx();
-  unsigned Ny = mean.call_Ny();
-
   const gsl_rng_type * GSLrngType;
   static gsl_rng * rngPoissonBinField = 0;
 
@@ -53,8 +74,15 @@ void RandomPoissonBinField (BinField<unsigned> &countrate, const BinField<double
     gsl_rng_set (rngPoissonBinField, seed);
   }
 
+  RandomPoissonBinField(countrate, mean, rngPoissonBinField);
+}
+void RandomPoissonBinField (BinField<unsigned> &countrate, const BinField<double> &mean, gsl_rng *rng)
+{
+  unsigned Nx = mean.call_Nx();
+  unsigned Ny = mean.call_Ny();
+
   for(unsigned ni = 0; ni < Nx*Ny; ni++)
-    countrate.assign(ni, gsl_ran_poisson (rngPoissonBinField, mean.call(ni)) );
+    countrate.assign(ni, gsl_ran_poisson (rng, mean.call(ni)) );
 }
 // -------------------------
 
@@ -76,7 +104,11 @@ double RandomRational (const unsigned &seed)
     gsl_rng_set (rngUniform, seed);
   }
 
-  return gsl_rng_uniform (rngUniform);
+  return RandomRational(rngUniform);
+}
+double RandomRational (gsl_rng *rng)
+{
+  return gsl_rng_uniform (rng);
 }
 
 
@@ -167,19 +199,17 @@ int RandomGSLInteger (const unsigned &N, const unsigned &seed)
     gsl_rng_set (rngInteger, seed);
   }
 
-  return gsl_rng_uniform_int (rngInteger, N);
+  return RandomGSLInteger(N, rngInteger);
+}
+int RandomGSLInteger (const unsigned &N, gsl_rng *rng)
+{
+  return gsl_rng_uniform_int (rng, N);
 }
 
 
 // Bernoulli Experiment
 bool RandomBernoulli (const double &p, const unsigned &seed)
 {
-  if( p < 0 || p > 1 )
-    {
-      std::cerr << "ERROR: RandomBernoulli recieved as probability p: " << p << std::endl;
-      exit(-1);
-    }
-
   const gsl_rng_type * GSLrngType;
   static gsl_rng * rngThresh = 0;
 
@@ -192,23 +222,23 @@ bool RandomBernoulli (const double &p, const unsigned &seed)
     gsl_rng_set (rngThresh, seed);
   }
 
-  return ( gsl_rng_uniform(rngThresh) < p );
+  return RandomBernoulli(p, rngThresh);
 }
-
-
-// Bernoulli Experiment on a BinField
-void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p, const unsigned &seed)
+bool RandomBernoulli (const double &p, gsl_rng *rng)
 {
-  unsigned Nx = p.call_Nx();
-  unsigned Ny = p.call_Ny();
-
-  if(Nx != sample.call_Nx() || Ny != sample.call_Ny() )
+  if( p < 0 || p > 1 )
     {
-      std::cerr << "ERROR: RandomBernoulliBinField recieved per reference sample and p BinFields;" << std::endl
-                << "       Dimensions do not match." << std::endl;
+      std::cerr << "ERROR: RandomBernoulli recieved as probability p: " << p << std::endl;
       exit(-1);
     }
 
+  return ( gsl_rng_uniform(rng) < p );
+}
+
+
+// Bernoulli Experiment on a BinField
+void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p, const unsigned &seed)
+{
   const gsl_rng_type * GSLrngType;
   static gsl_rng * rngThreshBinField = 0;
 
@@ -221,14 +251,25 @@ void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p,
     gsl_rng_set (rngThreshBinField, seed);
   }
 
+  RandomBernoulliBinField(sample, p, rngThreshBinField);
+}
+void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p, gsl_rng *rng)
+{
+  unsigned Nx = p.call_Nx();
+  unsigned Ny = p.call_Ny();
+
+  if(Nx != sample.call_Nx() || Ny != sample.call_Ny() )
+    {
+      std::cerr << "ERROR: RandomBernoulliBinField recieved per reference sample and p BinFields;" << std::endl
+                << "       Dimensions do not match." << std::endl;
+      exit(-1);
+    }
+
   for(unsigned ni = 0; ni < Nx*Ny; ni++)
-    sample.assign(ni, gsl_rng_uniform (rngThreshBinField) < p.call(ni));
+    sample.assign(ni, gsl_rng_uniform (rng) < p.call(ni));
 }
 void RandomBernoulliBinField_const_p (BinField<bool> &sample, const double &p, const unsigned &seed)
 {
-  unsigned Nx = sample.call_Nx();
-  unsigned Ny = sample.call_Ny();
-
   const gsl_rng_type * GSLrngType;
   static gsl_rng * rngThreshBinField = 0;
 
@@ -241,8 +282,15 @@ void RandomBernoulliBinField_const_p (BinField<bool> &sample, const double &p, c
     gsl_rng_set (rngThreshBinField, seed);
   }
 
+  RandomBernoulliBinField_const_p(sample, p, rngThreshBinField);
+}
+void RandomBernoulliBinField_const_p (BinField<bool> &sample, const double &p, gsl_rng *rng)
+{
+  unsigned Nx = sample.call_Nx();
+  unsigned Ny = sample.call_Ny();
+
   for(unsigned ni = 0; ni < Nx*Ny; ni++)
-    sample.assign(ni, gsl_rng_uniform (rngThreshBinField) < p);
+    sample.assign(ni, gsl_rng_uniform (rng) < p);
 }
 // -------------------------
 
@@ -263,22 +311,17 @@ unsigned RandomBinomial (const unsigned &n, const double &p, const unsigned &see
     gsl_rng_set (rngBino, seed);
   }
 
-  return gsl_ran_binomial(rngBino, p, n);
+  return RandomBinomial(n, p, rngBino);
+}
+unsigned RandomBinomial (const unsigned &n, const double &p, gsl_rng *rng)
+{
+  return gsl_ran_binomial(rng, p, n);
 }
 
 
 // Subtracting countrate BinField by Binomial Random Number Generator
 void SubtractRandomBinomial (BinField<unsigned> &countrate, const double &lambda, const BinField<double> &inty, const unsigned &seed)
 {
-  unsigned Nx = inty.call_Nx();
-  unsigned Ny = inty.call_Ny();
-
-  if(Nx != countrate.call_Nx() || Ny != countrate.call_Ny() )
-    {
-      std::cerr << "ERROR: RandomBernoulliBinField recieved per reference countrate and p BinFields;" << std::endl
-                << "       Dimensions do not match." << std::endl;
-      exit(-1);
-    }
   const gsl_rng_type * GSLrngType;
   static gsl_rng * rngBino = 0;
 
@@ -291,8 +334,22 @@ void SubtractRandomBinomial (BinField<unsigned> &countrate, const double &lambda
     gsl_rng_set (rngBino, seed);
   }
 
+  SubtractRandomBinomial(countrate, lambda, inty, rngBino);
+}
+void SubtractRandomBinomial (BinField<unsigned> &countrate, const double &lambda, const BinField<double> &inty, gsl_rng *rng)
+{
+  unsigned Nx = inty.call_Nx();
+  unsigned Ny = inty.call_Ny();
+
+  if(Nx != countrate.call_Nx() || Ny != countrate.call_Ny() )
+    {
+      std::cerr << "ERROR: RandomBernoulliBinField recieved per reference countrate and p BinFields;" << std::endl
+                << "       Dimensions do not match." << std::endl;
+      exit(-1);
+    }
+
   for(unsigned ni = 0; ni < Nx*Ny; ni++)
-    countrate.assign( ni, gsl_ran_binomial( rngBino, lambda/(lambda + inty.call(ni)), countrate.call(ni)) );
+    countrate.assign( ni, gsl_ran_binomial( rng, lambda/(lambda + inty.call(ni)), countrate.call(ni)) );
 
 }
 // -------------------------
@@ -313,7 +370,11 @@ double RandomGaussian(const double &mean, const double &sigma, const unsigned in
     gsl_rng_set (rngGauss, seed);
   }
 
-  return (mean + gsl_ran_gaussian (rngGauss, sigma)) ;
+  return RandomGaussian(mean, sigma, rngGauss);
+}
+double RandomGaussian(const double &mean, const double &sigma, gsl_rng *rng)
+{
+  return (mean + gsl_ran_gaussian (rng, sigma)) ;
 }
 
 
@@ -28,21 +28,83 @@
 // -------------------------
 // Random Number Generators:
 // -------------------------
+//
+// The generators with a seed argument keep a function-local static state,
+// which is seeded at the first call; they are not reentrant.
+// The overloads with a gsl_rng argument draw from a state that is owned by
+// the caller, e.g., one independent state per thread.
+// The CounterRNG has no state at all; its draws are pure functions of their indices.
+
+
+// -------------------------
+// Independent generator states (Mersenne twister)
+gsl_rng* AllocateRNG (const unsigned long &seed);
+void FreeRNG (gsl_rng *rng);
+// -------------------------
+
+
+// -------------------------
+// Counter-based generator (Philox4x32-10, Salmon et al., SC'11)
+//
+// The key is (seed, run) and the counter is (level, xi, yi), so that every single
+// draw of every run can be regenerated directly, without replaying the draws before it.
+inline void Philox4x32 (uint32_t ctr[4], const uint32_t key[2])
+{
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  for(unsigned round = 0; round < 10; round++){
+    uint64_t prod0 = uint64_t(0xD2511F53) * ctr[0];
+    uint64_t prod1 = uint64_t(0xCD9E8D57) * ctr[2];
+    uint32_t c0 = uint32_t(prod1 >> 32) ^ ctr[1] ^ k0;
+    uint32_t c2 = uint32_t(prod0 >> 32) ^ ctr[3] ^ k1;
+    ctr[0] = c0;
+    ctr[1] = uint32_t(prod1);
+    ctr[2] = c2;
+    ctr[3] = uint32_t(prod0);
+    k0 += 0x9E3779B9;
+    k1 += 0xBB67AE85;
+  }
+}
+
+class CounterRNG {
+
+ public:
+  CounterRNG (const unsigned &seed, const unsigned &run)
+  {
+    key_[0] = seed;
+    key_[1] = run;
+  }
+
+  // Uniform random number in [0;1) for the cell (xi,yi) in the level-th approximation
+  double uniform (const unsigned &level, const unsigned &xi, const unsigned &yi) const
+  {
+    uint32_t ctr[4] = {level, xi, yi, 0};
+    Philox4x32(ctr, key_);
+    return ctr[0] * (1./4294967296.);
+  }
+
+ private:
+  uint32_t key_[2];
+};
+// -------------------------
 
 
 // -------------------------
 // Random Number Generator of Poisson Distributed numbers
 unsigned RandomPoisson (const double &mean, const unsigned &seed);
+unsigned RandomPoisson (const double &mean, gsl_rng *rng);
 
 
 // Generator of Random Poisson Bin Fields
 void RandomPoissonBinField (BinField<unsigned> &countrate, const BinField<double> &mean, const unsigned &seed);
+void RandomPoissonBinField (BinField<unsigned> &countrate, const BinField<double> &mean, gsl_rng *rng);
 // -------------------------
 
 
 // -------------------------
 // Uniform Random Number Generator: 0 <= sample < 1; sample in [0;1)
 double RandomRational (const unsigned &seed);
+double RandomRational (gsl_rng *rng);
 
 
 // Random numbers r with r >=min and r < max
@@ -63,29 +125,36 @@ int RandomIntegerBetweenUpperLowerBound (const unsigned &n, const unsigned &N, c
 
 // Random numbers n with n >=0 and n < N
 int RandomGSLInteger (const unsigned &N, const unsigned &seed);
+int RandomGSLInteger (const unsigned &N, gsl_rng *rng);
 
 // Bernoulli Experiment
 bool RandomBernoulli (const double &p, const unsigned &seed);
+bool RandomBernoulli (const double &p, gsl_rng *rng);
 
 
 // Bernoulli Experiment on a BinField
 void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p, const unsigned &seed);
+void RandomBernoulliBinField (BinField<bool> &sample, const BinField<double> &p, gsl_rng *rng);
 void RandomBernoulliBinField_const_p (BinField<bool> &sample, const double &p, const unsigned &seed);
+void RandomBernoulliBinField_const_p (BinField<bool> &sample, const double &p, gsl_rng *rng);
 // -------------------------
 
 
 // -------------------------
 // Binomial Random Number Generator
 unsigned RandomBinomial (const unsigned &n, const double &p, const unsigned &seed);
+unsigned RandomBinomial (const unsigned &n, const double &p, gsl_rng *rng);
 
 
 // Subtracting countrate BinField by Binomial Random Number Generator
 void SubtractRandomBinomial (BinField<unsigned> &countrate, const double &lambda, const BinField<double> &inty, const unsigned &seed);
+void SubtractRandomBinomial (BinField<unsigned> &countrate, const double &lambda, const BinField<double> &inty, gsl_rng *rng);
 // -------------------------
 
 
 // Random number Gaussian distributed
 double RandomGaussian(const double &mean, const double &sigma, const unsigned int &seed);
+double RandomGaussian(const double &mean, const double &sigma, gsl_rng *rng);
 
 
 // -----------------------------------------
@@ -0,0 +1,153 @@
+/* check_minkowski
+ *
+ * Self-checks of the word-parallel kernels of the Minkowski functionals (make check)
+ *
+ * Author Michael Andreas Klatt (software@mklatt.org)
+ * Released under the GNU General Public License, version 3.
+ *
+ * Description
+ * Every instruction set of the row kernel of the window histograms that the CPU
+ * supports (see set_histogram_kernel) is compared with a histogram of the windows
+ * looked up one by one (see convert), and euler_wbc_pix, which sums
+ * euler_wbc_pix_rows over pairs of rows, with the sum of the tables rg*_euler_pix.
+ * The samples are random, with odd widths, rows of a single word, and widths
+ * that are no multiple of 64.
+ */
+
+#include "minkowski.h"
+
+static unsigned N_checks = 0;
+static unsigned N_failures = 0;
+
+static void check(const bool &passed, const std::string &what, const unsigned &Nx, const unsigned &Ny, const double &density)
+{
+  N_checks++;
+  if(!passed){
+    N_failures++;
+    std::cerr << "ERROR: " << what << " of a " << Nx << "x" << Ny << " sample with density " << density
+              << " (kernel " << histogram_kernel() << ");" << std::endl;
+  }
+}
+
+// Random sample whose pixels are true with probability density, keyed by (seed, run)
+static BinField<bool> random_sample(const unsigned &Nx, const unsigned &Ny, const double &density,
+                                    const unsigned &seed, const unsigned &run)
+{
+  CounterRNG rng(seed, run);
+  BinField<bool> sample(Nx, Ny, false);
+  for(unsigned xi = 0; xi < Nx; xi++)
+    for(unsigned yi = 0; yi < Ny; yi++)
+      sample.assign(xi, yi, rng.uniform(0, xi, yi) < density);
+  return sample;
+}
+
+// Pixel (x,y) of the sample, where x and y may reach out by one pixel:
+// periodic, or false outside of the sample
+static bool pixel(const BinField<bool> &sample, const int &x, const int &y, const bool &periodic)
+{
+  const int Nx = sample.call_Nx();
+  const int Ny = sample.call_Ny();
+  if(periodic)
+    return sample.call((x+Nx)%Nx, (y+Ny)%Ny);
+  if(x < 0 || y < 0 || x >= Nx || y >= Ny)
+    return false;
+  return sample.call(x, y);
+}
+
+// Reference histogram of the windows (X,Y), whose lower left pixel is (X-shift,Y-shift), with
+// N_windows_x x N_windows_y windows; the range is 7, 4, or 1 per row plus 0, 1, or 2 per column
+static void reference_histogram(const BinField<bool> &sample, const int &shift, const bool &periodic,
+                                const unsigned &N_windows_x, const unsigned &N_windows_y,
+                                WindowHistogram &histogram)
+{
+  for(unsigned range = 0; range < 10; range++)
+    for(unsigned conf = 0; conf < 16; conf++)
+      histogram.counts[range][conf] = 0;
+
+  for(unsigned Y = 0; Y < N_windows_y; Y++)
+    for(unsigned X = 0; X < N_windows_x; X++){
+      const unsigned range = ((Y == 0) ? 7 : ((Y == N_windows_y-1) ? 1 : 4))
+                           + ((X == 0) ? 0 : ((X == N_windows_x-1) ? 2 : 1));
+      const int x = int(X) - shift;
+      const int y = int(Y) - shift;
+      histogram.counts[range][convert(pixel(sample,x+1,y,periodic), pixel(sample,x,y,periodic),
+                                      pixel(sample,x+1,y+1,periodic), pixel(sample,x,y+1,periodic))]++;
+    }
+}
+
+static bool equal(const WindowHistogram &first, const WindowHistogram &second)
+{
+  for(unsigned range = 0; range < 10; range++)
+    for(unsigned conf = 0; conf < 16; conf++)
+      if(first.counts[range][conf] != second.counts[range][conf])
+        return false;
+  return true;
+}
+
+// Sum of the tables of all ranges (times 8) over the windows of a histogram
+static long table_sum(const WindowHistogram &histogram, const RangeTables<int> &tables)
+{
+  long total = 0;
+  for(unsigned range = 1; range < 10; range++)
+    for(unsigned conf = 0; conf < 16; conf++)
+      total += histogram.counts[range][conf] * tables[range][conf];
+  return total;
+}
+
+static void check_sample(const BinField<bool> &sample, const double &density)
+{
+  const unsigned Nx = sample.call_Nx();
+  const unsigned Ny = sample.call_Ny();
+  WindowHistogram histogram, reference;
+
+  // row kernel: minus sampling and periodic boundary condition, in one band and in three
+  reference_histogram(sample, 0, false, Nx-1, Ny-1, reference);
+  histogram_mbc(sample, histogram);
+  check(equal(histogram, reference), "histogram_mbc", Nx, Ny, density);
+  histogram_mbc(sample, histogram, 3);
+  check(equal(histogram, reference), "histogram_mbc with three bands", Nx, Ny, density);
+
+  reference_histogram(sample, 1, true, Nx+1, Ny+1, reference);
+  histogram_pbc(sample, histogram);
+  check(equal(histogram, reference), "histogram_pbc", Nx, Ny, density);
+  histogram_pbc(sample, histogram, 3);
+  check(equal(histogram, reference), "histogram_pbc with three bands", Nx, Ny, density);
+
+  // euler_wbc_pix_rows: the windows reach out by one pixel into a false surrounding
+  reference_histogram(sample, 1, false, Nx+1, Ny+1, reference);
+  check(euler_wbc_pix(sample) == table_sum(reference, euler_pix_tables), "euler_wbc_pix", Nx, Ny, density);
+
+  // the complement, whose rows are inverted on the fly
+  BinField<bool> complement = sample;
+  complement.invert();
+  reference_histogram(complement, 1, false, Nx+1, Ny+1, reference);
+  check(euler_wbc_pix(sample, true) == table_sum(reference, euler_pix_tables),
+        "euler_wbc_pix of the complement", Nx, Ny, density);
+}
+
+int main(){
+  // odd widths, a single word, a multiple of 64, and widths that are no multiple of 64,
+  // long enough for several vectors of the widest kernel
+  const unsigned widths[] = { 3, 5, 17, 63, 64, 65, 127, 128, 129, 255, 333, 640, 1001 };
+  const unsigned heights[] = { 3, 4, 9, 36 };
+  const double densities[] = { 0.1, 0.5, 0.9 };
+
+  std::vector<std::string> kernels = histogram_kernels();
+  for(unsigned ki = 0; ki < kernels.size(); ki++){
+    if(!set_histogram_kernel(kernels[ki])){
+      std::cerr << "ERROR: cannot select the kernel " << kernels[ki] << ";" << std::endl;
+      return 1;
+    }
+
+    unsigned run = 0;
+    for(unsigned wi = 0; wi < sizeof(widths)/sizeof(widths[0]); wi++)
+      for(unsigned hi = 0; hi < sizeof(heights)/sizeof(heights[0]); hi++)
+        for(unsigned di = 0; di < sizeof(densities)/sizeof(densities[0]); di++)
+          check_sample(random_sample(widths[wi], heights[hi], densities[di], 17, run++), densities[di]);
+
+    std::cout << "kernel " << kernels[ki] << ": " << run << " samples checked" << std::endl;
+  }
+
+  std::cout << N_checks - N_failures << " of " << N_checks << " checks passed" << std::endl;
+  return N_failures ? 1 : 0;
+}